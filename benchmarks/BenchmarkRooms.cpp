@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include "nlohmann/json.hpp"
+#include "GGPack.h"
+#include "BenchmarkRooms.h"
+#include "_NGUtil.h"
+
+namespace ng
+{
+// some queries start outside of the walkboxes, to measure the snapping to the edges
+static const int QueryMargin = 10;
+
+// the walkboxes are pairs of a name and a polygon
+static void _addRoom(const std::string &name, const std::string &roomSize,
+                     const std::vector<std::pair<std::string, std::string>> &walkboxes, std::vector<BenchmarkRoom> &rooms)
+{
+    BenchmarkRoom room;
+    room.name = name;
+    room.roomSize = roomSize;
+    auto height = static_cast<int>(_parsePos(roomSize).y);
+    for (const auto &walkbox : walkboxes)
+    {
+        std::vector<sf::Vector2i> vertices;
+        _parsePolygon(walkbox.second, vertices, height);
+        room.walkboxes.emplace_back(vertices);
+        room.walkboxes.back().setName(walkbox.first);
+    }
+    if (!room.walkboxes.empty())
+    {
+        rooms.push_back(std::move(room));
+    }
+}
+
+void loadPackRooms(const std::string &path, std::vector<BenchmarkRoom> &rooms)
+{
+    GGPack pack;
+    pack.open(path);
+    std::vector<std::string> entries;
+    pack.getEntries(entries);
+    for (const auto &entry : entries)
+    {
+        auto extension = entry.find(".wimpy");
+        if (extension == std::string::npos)
+            continue;
+
+        GGPackValue hash;
+        pack.readHashEntry(entry, hash);
+        std::vector<std::pair<std::string, std::string>> walkboxes;
+        for (auto &jWalkbox : hash["walkboxes"].array_value)
+        {
+            walkboxes.emplace_back(jWalkbox["name"].string_value, jWalkbox["polygon"].string_value);
+        }
+        _addRoom(entry.substr(0, extension), hash["roomsize"].string_value, walkboxes, rooms);
+    }
+}
+
+void loadFixtureRooms(const std::string &directory, std::vector<BenchmarkRoom> &rooms)
+{
+    std::vector<std::filesystem::path> paths;
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (entry.path().extension() == ".wimpy")
+        {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    for (const auto &path : paths)
+    {
+        std::ifstream input(path);
+        auto jWimpy = nlohmann::json::parse(input, nullptr, false);
+        if (jWimpy.is_discarded())
+        {
+            std::cerr << "Invalid room " << path << std::endl;
+            continue;
+        }
+        std::vector<std::pair<std::string, std::string>> walkboxes;
+        for (const auto &jWalkbox : jWimpy["walkboxes"])
+        {
+            walkboxes.emplace_back(jWalkbox.value("name", ""), jWalkbox["polygon"].get<std::string>());
+        }
+        _addRoom(path.stem().string(), jWimpy["roomsize"].get<std::string>(), walkboxes, rooms);
+    }
+}
+
+void loadBenchmarkRooms(const std::string &fixtures, std::vector<BenchmarkRoom> &rooms)
+{
+    loadPackRooms("ThimbleweedPark.ggpack1", rooms);
+    loadPackRooms("ThimbleweedPark.ggpack2", rooms);
+    if (rooms.empty())
+    {
+        loadFixtureRooms(fixtures, rooms);
+    }
+}
+
+sf::IntRect getBounds(const std::vector<Walkbox> &walkboxes)
+{
+    auto bounds = walkboxes[0].getBounds();
+    for (const auto &walkbox : walkboxes)
+    {
+        auto rect = walkbox.getBounds();
+        auto left = std::min(bounds.left, rect.left);
+        auto top = std::min(bounds.top, rect.top);
+        auto right = std::max(bounds.left + bounds.width, rect.left + rect.width);
+        auto bottom = std::max(bounds.top + bounds.height, rect.top + rect.height);
+        bounds = sf::IntRect(left, top, right - left, bottom - top);
+    }
+    return bounds;
+}
+
+BenchmarkQueries generateQueries(const BenchmarkRoom &room, int count, std::mt19937 &generator)
+{
+    auto bounds = getBounds(room.walkboxes);
+    auto x = [&generator, &bounds]() {
+        return bounds.left - QueryMargin + static_cast<int>(generator() % (bounds.width + 2 * QueryMargin + 1));
+    };
+    auto y = [&generator, &bounds]() {
+        return bounds.top - QueryMargin + static_cast<int>(generator() % (bounds.height + 2 * QueryMargin + 1));
+    };
+    BenchmarkQueries queries;
+    for (int i = 0; i < count; i++)
+    {
+        auto from = sf::Vector2i(x(), y());
+        queries.emplace_back(from, sf::Vector2i(x(), y()));
+    }
+    return queries;
+}
+} // namespace ng
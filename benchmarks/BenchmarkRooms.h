@@ -0,0 +1,31 @@
+#pragma once
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Walkbox.h"
+
+// Walkboxes of the rooms used by the path finder benchmark and checks.
+namespace ng
+{
+struct BenchmarkRoom
+{
+  std::string name;
+  std::string roomSize;
+  std::vector<Walkbox> walkboxes;
+};
+
+using BenchmarkQueries = std::vector<std::pair<sf::Vector2i, sf::Vector2i>>;
+
+// Reads the rooms of a pack, nothing is added when the pack doesn't exist.
+void loadPackRooms(const std::string &path, std::vector<BenchmarkRoom> &rooms);
+// Reads the .wimpy files of a directory, sorted by name.
+void loadFixtureRooms(const std::string &directory, std::vector<BenchmarkRoom> &rooms);
+// Reads the rooms of the packs of the working directory, or of the fixtures directory when there is no pack.
+void loadBenchmarkRooms(const std::string &fixtures, std::vector<BenchmarkRoom> &rooms);
+
+sf::IntRect getBounds(const std::vector<Walkbox> &walkboxes);
+// Random queries around the walkboxes, some of them start or end outside to exercise the snapping to the edges.
+// Only the engine of the generator is used so the queries are the same with every standard library.
+BenchmarkQueries generateQueries(const BenchmarkRoom &room, int count, std::mt19937 &generator);
+} // namespace ng
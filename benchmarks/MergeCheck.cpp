@@ -0,0 +1,300 @@
+// Checks the outlines of the walkboxes merged by the engine against the ones the previous merge produced.
+// A fixture is a room with the walkboxes to merge, the outlines of the previous merge in "merged" and the
+// positions which must be "walkable" or "blocked" once they are merged, in the coordinates of the room.
+// The intentional differences with the previous merge are recorded in the fixture: the outlines it no longer
+// produces in "dropped", the ones it produces instead in "added" and why in "note".
+// The check fails when "merged" isn't the outline of the previous merge any more, when an outline differs
+// from the expected ones or when a position differs.
+//   ./mergeCheck [fixtures]
+// Writes a fixture for each room of the packs of the working directory, or of the rooms directory when
+// there is no pack, with the outlines of the previous merge. The existing fixtures are kept.
+//   ./mergeCheck extract [rooms] [fixtures]
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include "nlohmann/json.hpp"
+#include "Walkbox.h"
+#include "_NGUtil.h"
+#include "BenchmarkRooms.h"
+#include "_LegacyMerge.h"
+
+namespace
+{
+using Outline = std::vector<sf::Vector2i>;
+
+const char *DroppedFirstWalkboxNote =
+    "The previous merge kept the first walkbox next to the merged outline, it is dropped as it lies inside.";
+const char *RepeatedVerticesNote = "The previous merge repeated the vertices between two shared edges.";
+
+bool less(const sf::Vector2i &v1, const sf::Vector2i &v2) { return std::tie(v1.x, v1.y) < std::tie(v2.x, v2.y); }
+
+// the outlines start with their smallest vertex so they can be compared whatever the vertex they start with
+Outline normalize(Outline outline)
+{
+    std::rotate(outline.begin(), std::min_element(outline.begin(), outline.end(), less), outline.end());
+    return outline;
+}
+
+std::vector<Outline> sortOutlines(std::vector<Outline> outlines)
+{
+    for (auto &outline : outlines)
+    {
+        outline = normalize(outline);
+    }
+    std::sort(outlines.begin(), outlines.end(), [](const Outline &o1, const Outline &o2) {
+        return std::lexicographical_compare(o1.begin(), o1.end(), o2.begin(), o2.end(), less);
+    });
+    return outlines;
+}
+
+std::vector<Outline> getOutlines(const std::vector<ng::Walkbox> &walkboxes)
+{
+    std::vector<Outline> outlines;
+    for (const auto &walkbox : walkboxes)
+    {
+        outlines.push_back(walkbox.getVertices());
+    }
+    return outlines;
+}
+
+std::vector<Outline> parseOutlines(const nlohmann::json &jPolygons, int height)
+{
+    std::vector<Outline> outlines;
+    for (const auto &jPolygon : jPolygons)
+    {
+        Outline vertices;
+        ng::_parsePolygon(jPolygon.get<std::string>(), vertices, height);
+        outlines.push_back(vertices);
+    }
+    return outlines;
+}
+
+Outline removeRepeatedVertices(Outline outline)
+{
+    outline.erase(std::unique(outline.begin(), outline.end()), outline.end());
+    while (outline.size() > 1 && outline.front() == outline.back())
+    {
+        outline.pop_back();
+    }
+    return outline;
+}
+
+std::string toPolygon(const Outline &outline, int height)
+{
+    std::ostringstream polygon;
+    for (size_t i = 0; i < outline.size(); i++)
+    {
+        polygon << (i == 0 ? "{" : ";{") << outline[i].x << ',' << height - outline[i].y << '}';
+    }
+    return polygon.str();
+}
+
+void printOutlines(const std::vector<Outline> &outlines, int height)
+{
+    for (const auto &outline : outlines)
+    {
+        std::cerr << "    " << toPolygon(outline, height) << std::endl;
+    }
+}
+
+bool compareOutlines(const std::string &name, const char *merge, std::vector<Outline> outlines,
+                     std::vector<Outline> expected, int height)
+{
+    outlines = sortOutlines(outlines);
+    expected = sortOutlines(expected);
+    if (outlines == expected)
+        return true;
+
+    std::cerr << name << ": the outlines of the " << merge << " merge are" << std::endl;
+    printOutlines(outlines, height);
+    std::cerr << "  instead of" << std::endl;
+    printOutlines(expected, height);
+    return false;
+}
+
+bool checkRoom(const std::filesystem::path &path)
+{
+    std::ifstream input(path);
+    auto jWimpy = nlohmann::json::parse(input, nullptr, false);
+    if (jWimpy.is_discarded())
+    {
+        std::cerr << "Invalid room " << path << std::endl;
+        return false;
+    }
+
+    auto name = path.stem().string();
+    auto height = static_cast<int>(ng::_parsePos(jWimpy["roomsize"].get<std::string>()).y);
+    std::vector<ng::Walkbox> walkboxes;
+    for (const auto &jWalkbox : jWimpy["walkboxes"])
+    {
+        Outline vertices;
+        ng::_parsePolygon(jWalkbox["polygon"].get<std::string>(), vertices, height);
+        walkboxes.emplace_back(vertices);
+        walkboxes.back().setName(jWalkbox["name"].get<std::string>());
+    }
+    auto previous = parseOutlines(jWimpy["merged"], height);
+
+    std::vector<ng::Walkbox> legacyMerged;
+    ng::legacyMerge(walkboxes, legacyMerged);
+    auto isValid = compareOutlines(name, "previous", getOutlines(legacyMerged), previous, height);
+
+    // what the previous merge produced, without the outlines dropped and with the ones added since
+    auto expected = sortOutlines(previous);
+    for (const auto &outline : sortOutlines(parseOutlines(jWimpy["dropped"], height)))
+    {
+        auto it = std::find(expected.begin(), expected.end(), outline);
+        if (it == expected.end())
+        {
+            std::cerr << name << ": the dropped outline " << toPolygon(outline, height) << " isn't merged" << std::endl;
+            isValid = false;
+            continue;
+        }
+        expected.erase(it);
+    }
+    auto added = parseOutlines(jWimpy["added"], height);
+    expected.insert(expected.end(), added.begin(), added.end());
+
+    std::vector<ng::Walkbox> merged;
+    ng::merge(walkboxes, merged);
+    isValid &= compareOutlines(name, "engine", getOutlines(merged), expected, height);
+
+    auto checkPositions = [&](const char *key, bool isWalkable) {
+        for (const auto &jPos : jWimpy[key])
+        {
+            auto pos = ng::_parsePos(jPos.get<std::string>());
+            auto position = sf::Vector2i(static_cast<int>(pos.x), height - static_cast<int>(pos.y));
+            auto isInside = std::any_of(merged.begin(), merged.end(), [&position](const ng::Walkbox &walkbox) {
+                return walkbox.isEnabled() && walkbox.inside(position);
+            });
+            if (isInside == isWalkable)
+                continue;
+            std::cerr << name << ": " << jPos.get<std::string>() << " is " << (isInside ? "walkable" : "blocked")
+                      << " instead of " << key << std::endl;
+            isValid = false;
+        }
+    };
+    checkPositions("walkable", true);
+    checkPositions("blocked", false);
+
+    std::cout << name << ": " << walkboxes.size() << " walkboxes merged into " << merged.size() << ", "
+              << (isValid ? "ok" : "MISMATCH") << std::endl;
+    return isValid;
+}
+
+int checkRooms(const std::string &fixtures)
+{
+    std::vector<std::filesystem::path> paths;
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(fixtures, error))
+    {
+        if (entry.path().extension() == ".wimpy")
+        {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    if (paths.empty())
+    {
+        std::cerr << "No room found in " << fixtures << std::endl;
+        return 1;
+    }
+
+    size_t mismatchCount = 0;
+    for (const auto &path : paths)
+    {
+        if (!checkRoom(path))
+        {
+            mismatchCount++;
+        }
+    }
+    if (mismatchCount != 0)
+    {
+        std::cerr << mismatchCount << " of " << paths.size() << " rooms are not merged as expected" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// the differences the previous merge always made are recorded here,
+// the others are found by the check and recorded by hand once they are reviewed
+int extractRooms(const std::string &roomsDirectory, const std::string &fixtures)
+{
+    std::vector<ng::BenchmarkRoom> rooms;
+    ng::loadBenchmarkRooms(roomsDirectory, rooms);
+    if (rooms.empty())
+    {
+        std::cerr << "No room found in the packs or in " << roomsDirectory << std::endl;
+        return 1;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(fixtures, error);
+    for (const auto &room : rooms)
+    {
+        auto path = std::filesystem::path(fixtures) / (room.name + ".wimpy");
+        if (std::filesystem::exists(path))
+        {
+            std::cout << room.name << ": kept" << std::endl;
+            continue;
+        }
+
+        auto height = static_cast<int>(ng::_parsePos(room.roomSize).y);
+        nlohmann::json jWimpy;
+        jWimpy["name"] = room.name;
+        jWimpy["roomsize"] = room.roomSize;
+        jWimpy["walkboxes"] = nlohmann::json::array();
+        for (const auto &walkbox : room.walkboxes)
+        {
+            jWimpy["walkboxes"].push_back(
+                {{"name", walkbox.getName()}, {"polygon", toPolygon(walkbox.getVertices(), height)}});
+        }
+        std::vector<ng::Walkbox> legacyMerged;
+        ng::legacyMerge(room.walkboxes, legacyMerged);
+        jWimpy["merged"] = nlohmann::json::array();
+        jWimpy["dropped"] = {toPolygon(room.walkboxes[0].getVertices(), height)};
+        jWimpy["added"] = nlohmann::json::array();
+        std::string note = DroppedFirstWalkboxNote;
+        for (const auto &outline : getOutlines(legacyMerged))
+        {
+            jWimpy["merged"].push_back(toPolygon(outline, height));
+            auto vertices = removeRepeatedVertices(outline);
+            if (vertices.size() == outline.size())
+                continue;
+            jWimpy["dropped"].push_back(toPolygon(outline, height));
+            jWimpy["added"].push_back(toPolygon(vertices, height));
+            if (note.find(RepeatedVerticesNote) == std::string::npos)
+            {
+                note = note + ' ' + RepeatedVerticesNote;
+            }
+        }
+        jWimpy["note"] = note;
+
+        std::ofstream output(path);
+        output << jWimpy.dump(4) << std::endl;
+        if (!output)
+        {
+            std::cerr << "Failed to write " << path << std::endl;
+            return 1;
+        }
+        std::cout << room.name << ": " << room.walkboxes.size() << " walkboxes merged into " << legacyMerged.size()
+                  << " by the previous merge" << std::endl;
+    }
+    return 0;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && std::string(argv[1]) == "extract")
+    {
+        std::string rooms = argc > 2 ? argv[2] : "benchmarks/fixtures";
+        std::string fixtures = argc > 3 ? argv[3] : "benchmarks/fixtures/outlines";
+        return extractRooms(rooms, fixtures);
+    }
+
+    std::string fixtures = argc > 1 ? argv[1] : "benchmarks/fixtures/outlines";
+    return checkRooms(fixtures);
+}
@@ -0,0 +1,282 @@
+// Measures the walk graph build and the path queries of the PathFinder on the walkboxes of the rooms.
+// The rooms are read from the packs of the working directory, or from the .wimpy files of the fixtures
+// directory when there is no pack (a room loaded by the engine is written to a .wimpy file it can use).
+// Each room is measured with both path finders, the checksums of the paths change when a path does.
+// With precompute set to 1, the visibility graph queries use the shortest paths precomputed between the concave vertices.
+// The lengths and the checksums are compared to the ones of expected.txt in the fixtures directory, the benchmark
+// fails when one of them differs. With update set to 1, the results of the run are written to expected.txt instead.
+//   ./pathFinderBenchmark [queries] [precompute] [fixtures] [update]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <sstream>
+#include <thread>
+#include "BenchmarkRooms.h"
+#include "PathFinder.h"
+#include "_NGUtil.h"
+
+namespace
+{
+std::atomic<size_t> g_allocations{0};
+}
+
+void *operator new(std::size_t size)
+{
+    g_allocations++;
+    if (auto p = std::malloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// the lengths are written with 3 decimals
+const double LengthTolerance = 0.01;
+
+struct Result
+{
+    double buildTime{0};
+    double p50{0};
+    double p99{0};
+    double allocations{0};
+    double length{0};
+    size_t checksum{0};
+};
+
+struct Expected
+{
+    double length{0};
+    size_t checksum{0};
+};
+
+// the results are keyed by room, mode, number of queries and precompute
+using ExpectedResults = std::map<std::string, Expected>;
+
+std::string getExpectedKey(const std::string &room, const char *mode, int queryCount, bool precompute)
+{
+    std::ostringstream key;
+    key << room << ' ' << mode << ' ' << queryCount << ' ' << (precompute ? 1 : 0);
+    return key.str();
+}
+
+ExpectedResults loadExpected(const std::string &path)
+{
+    ExpectedResults results;
+    std::ifstream input(path);
+    std::string line;
+    while (std::getline(input, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        std::string room, mode;
+        int queryCount = 0, precompute = 0;
+        Expected expected;
+        fields >> room >> mode >> queryCount >> precompute >> expected.length >> std::hex >> expected.checksum;
+        if (!fields)
+        {
+            std::cerr << "Invalid expected result " << line << std::endl;
+            continue;
+        }
+        results[getExpectedKey(room, mode.c_str(), queryCount, precompute != 0)] = expected;
+    }
+    return results;
+}
+
+bool saveExpected(const std::string &path, const ExpectedResults &results)
+{
+    std::ofstream output(path);
+    output << "# room mode queries precompute length checksum" << std::endl;
+    for (const auto &result : results)
+    {
+        output << result.first << ' ' << std::fixed << std::setprecision(3) << result.second.length << ' ' << std::hex
+               << std::setw(16) << std::setfill('0') << result.second.checksum << std::setfill(' ') << std::dec
+               << std::endl;
+    }
+    return static_cast<bool>(output);
+}
+
+double getElapsed(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+double getPercentile(std::vector<double> values, double percentile)
+{
+    auto index = static_cast<size_t>(percentile * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+Result measure(const std::vector<ng::Walkbox> &walkboxes, ng::PathFinderMode mode, bool precompute,
+               const ng::BenchmarkQueries &queries)
+{
+    Result result;
+    ng::PathFinder pathFinder(walkboxes, mode);
+
+    // the first query builds the walk graph, the navmesh is built by precomputePaths
+    auto start = Clock::now();
+    if (mode == ng::PathFinderMode::NavMesh || precompute)
+    {
+        pathFinder.precomputePaths();
+        // the paths of a graph too big for the tables are never precomputed
+        auto isPrecomputed = mode == ng::PathFinderMode::NavMesh ||
+                             pathFinder.getGraph()->nodes.size() <= ng::PathFinder::MaxPrecomputedNodes;
+        while (isPrecomputed && !pathFinder.hasPrecomputedPaths())
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    pathFinder.calculatePath(queries[0].first, queries[0].second);
+    result.buildTime = getElapsed(start) / 1000.0;
+
+    std::vector<double> latencies;
+    latencies.reserve(queries.size());
+    auto allocations = g_allocations.load();
+    for (const auto &query : queries)
+    {
+        start = Clock::now();
+        auto path = pathFinder.calculatePath(query.first, query.second);
+        latencies.push_back(getElapsed(start));
+
+        for (size_t i = 1; i < path.size(); i++)
+        {
+            auto delta = path[i] - path[i - 1];
+            result.length += std::sqrt(static_cast<double>(delta.x * delta.x + delta.y * delta.y));
+        }
+        for (const auto &node : path)
+        {
+            result.checksum = result.checksum * 31 + static_cast<size_t>(node.x * 1000 + node.y);
+        }
+    }
+    result.allocations = static_cast<double>(g_allocations.load() - allocations) / queries.size();
+    result.p50 = getPercentile(latencies, 0.5);
+    result.p99 = getPercentile(latencies, 0.99);
+    return result;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int queryCount = argc > 1 ? std::atoi(argv[1]) : 5000;
+    bool precompute = argc > 2 && std::atoi(argv[2]) != 0;
+    std::string fixtures = argc > 3 ? argv[3] : "benchmarks/fixtures";
+    bool update = argc > 4 && std::atoi(argv[4]) != 0;
+    if (queryCount <= 0)
+    {
+        std::cerr << "The number of queries must be positive" << std::endl;
+        return 1;
+    }
+
+    std::vector<ng::BenchmarkRoom> rooms;
+    ng::loadBenchmarkRooms(fixtures, rooms);
+    if (rooms.empty())
+    {
+        std::cerr << "No room found in the packs or in " << fixtures << std::endl;
+        return 1;
+    }
+
+    const std::pair<ng::PathFinderMode, const char *> modes[] = {{ng::PathFinderMode::VisibilityGraph, "graph"},
+                                                                 {ng::PathFinderMode::NavMesh, "navmesh"}};
+    size_t checksums[2] = {0, 0};
+    double lengths[2] = {0, 0};
+    auto expectedPath = (std::filesystem::path(fixtures) / "expected.txt").string();
+    auto expectedResults = loadExpected(expectedPath);
+    size_t checkedCount = 0, mismatchCount = 0;
+
+    std::cout << std::left << std::setw(24) << "room" << std::setw(9) << "mode" << std::right << std::setw(11) << "build ms"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(9) << "allocs" << std::setw(14)
+              << "length" << "  checksum" << std::endl;
+    for (const auto &room : rooms)
+    {
+        // the engine merges the walkboxes before building the path finder
+        std::vector<ng::Walkbox> walkboxes;
+        ng::merge(room.walkboxes, walkboxes);
+
+        // the queries only depend on the room so they can be compared between the runs
+        std::seed_seq seed(room.name.begin(), room.name.end());
+        std::mt19937 generator(seed);
+        auto queries = ng::generateQueries(room, queryCount, generator);
+
+        for (size_t i = 0; i < 2; i++)
+        {
+            auto result = measure(walkboxes, modes[i].first, precompute, queries);
+            checksums[i] = checksums[i] * 31 + result.checksum;
+            lengths[i] += result.length;
+
+            const char *status = "";
+            auto isMismatch = false;
+            auto key = getExpectedKey(room.name, modes[i].second, queryCount, precompute);
+            auto it = expectedResults.find(key);
+            if (update)
+            {
+                expectedResults[key] = {result.length, result.checksum};
+            }
+            else if (it != expectedResults.end())
+            {
+                checkedCount++;
+                isMismatch = std::abs(result.length - it->second.length) > LengthTolerance ||
+                             result.checksum != it->second.checksum;
+                status = isMismatch ? "  MISMATCH" : "  ok";
+                if (isMismatch)
+                {
+                    mismatchCount++;
+                }
+            }
+            std::cout << std::left << std::setw(24) << room.name << std::setw(9) << modes[i].second << std::right << std::fixed
+                      << std::setprecision(3) << std::setw(11) << result.buildTime << std::setprecision(2) << std::setw(10)
+                      << result.p50 << std::setw(10) << result.p99 << std::setw(9) << result.allocations << std::setw(14)
+                      << result.length << "  " << std::hex << std::setw(16) << std::setfill('0') << result.checksum
+                      << std::setfill(' ') << std::dec << status << std::endl;
+            if (isMismatch)
+            {
+                std::cerr << "  expected length " << std::fixed << std::setprecision(3) << it->second.length
+                          << ", checksum " << std::hex << std::setw(16) << std::setfill('0') << it->second.checksum
+                          << std::setfill(' ') << std::dec << std::endl;
+            }
+        }
+    }
+
+    std::cout << rooms.size() << " rooms, " << queryCount << " queries per room" << std::endl;
+    for (size_t i = 0; i < 2; i++)
+    {
+        std::cout << modes[i].second << ": length " << std::fixed << std::setprecision(3) << lengths[i] << ", checksum "
+                  << std::hex << checksums[i] << std::dec << std::endl;
+    }
+
+    if (update)
+    {
+        if (!saveExpected(expectedPath, expectedResults))
+        {
+            std::cerr << "Unable to write " << expectedPath << std::endl;
+            return 1;
+        }
+        std::cout << "Expected results written to " << expectedPath << std::endl;
+        return 0;
+    }
+    if (checkedCount == 0)
+    {
+        std::cout << "No expected result for this run in " << expectedPath << std::endl;
+    }
+    if (mismatchCount != 0)
+    {
+        std::cerr << mismatchCount << " of " << checkedCount << " results differ from " << expectedPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+// Compares the cost of the paths found by the A* search of the visibility graph with the ones of the
+// shortest paths precomputed with Dijkstra between all its nodes, on random queries in the walkboxes of the rooms.
+// The rooms are the ones of the path finder benchmark, the check fails when a cost differs.
+//   ./pathFinderCheck [queries] [seed] [fixtures]
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include "BenchmarkRooms.h"
+#include "PathFinder.h"
+#include "_NGUtil.h"
+
+namespace
+{
+// the costs are sums of floats, accumulated in a different order by the two searches
+const double AbsoluteTolerance = 0.01;
+const double RelativeTolerance = 1e-5;
+// only the first mismatches of a room are detailed
+const int MaxReportedMismatches = 5;
+
+double getLength(const std::vector<sf::Vector2i> &path)
+{
+    double length = 0;
+    for (size_t i = 1; i < path.size(); i++)
+    {
+        auto delta = path[i] - path[i - 1];
+        length += std::sqrt(static_cast<double>(delta.x * delta.x + delta.y * delta.y));
+    }
+    return length;
+}
+
+std::ostream &operator<<(std::ostream &os, const sf::Vector2i &pos)
+{
+    return os << '(' << pos.x << ',' << pos.y << ')';
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int queryCount = argc > 1 ? std::atoi(argv[1]) : 2000;
+    auto seed = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 1u;
+    std::string fixtures = argc > 3 ? argv[3] : "benchmarks/fixtures";
+    if (queryCount <= 0)
+    {
+        std::cerr << "The number of queries must be positive" << std::endl;
+        return 1;
+    }
+
+    std::vector<ng::BenchmarkRoom> rooms;
+    ng::loadBenchmarkRooms(fixtures, rooms);
+    if (rooms.empty())
+    {
+        std::cerr << "No room found in the packs or in " << fixtures << std::endl;
+        return 1;
+    }
+
+    size_t checkedCount = 0, mismatchCount = 0;
+    for (const auto &room : rooms)
+    {
+        std::vector<ng::Walkbox> walkboxes;
+        ng::merge(room.walkboxes, walkboxes);
+
+        // the reference: the queries link their ends to the shortest paths of ShortestPaths::compute
+        ng::PathFinder dijkstra(walkboxes);
+        dijkstra.precomputePaths();
+        if (dijkstra.getGraph()->nodes.size() > ng::PathFinder::MaxPrecomputedNodes)
+        {
+            std::cout << room.name << ": " << dijkstra.getGraph()->nodes.size() << " nodes, too many to precompute, skipped"
+                      << std::endl;
+            continue;
+        }
+        while (!dijkstra.hasPrecomputedPaths())
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        ng::PathFinder astar(walkboxes);
+
+        std::vector<unsigned> seedData(room.name.begin(), room.name.end());
+        seedData.push_back(seed);
+        std::seed_seq seedSequence(seedData.begin(), seedData.end());
+        std::mt19937 generator(seedSequence);
+        auto queries = ng::generateQueries(room, queryCount, generator);
+
+        auto roomMismatchCount = 0;
+        for (const auto &query : queries)
+        {
+            auto expectedPath = dijkstra.calculatePath(query.first, query.second);
+            auto path = astar.calculatePath(query.first, query.second);
+            auto expected = getLength(expectedPath);
+            auto length = getLength(path);
+            checkedCount++;
+            if (std::abs(length - expected) <= AbsoluteTolerance + RelativeTolerance * expected)
+                continue;
+
+            mismatchCount++;
+            if (++roomMismatchCount <= MaxReportedMismatches)
+            {
+                std::cerr << room.name << ": path from " << query.first << " to " << query.second << " costs " << std::fixed
+                          << std::setprecision(3) << length << " with A* instead of " << expected << std::endl;
+            }
+        }
+        std::cout << room.name << ": " << queries.size() << " queries, " << roomMismatchCount << " mismatches" << std::endl;
+    }
+
+    if (mismatchCount != 0)
+    {
+        std::cerr << mismatchCount << " of " << checkedCount << " A* paths differ from the shortest paths (seed " << seed
+                  << ")" << std::endl;
+        return 1;
+    }
+    std::cout << checkedCount << " A* paths match the shortest paths (seed " << seed << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,129 @@
+// Compares the fill cost of drawing the scene directly into the window
+// with drawing it into a native resolution render texture upscaled once.
+// Run it on software GL to get the numbers of the CI:
+//   LIBGL_ALWAYS_SOFTWARE=1 GALLIUM_DRIVER=llvmpipe ./renderTargetBenchmark
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "SFML/Graphics.hpp"
+
+namespace
+{
+const unsigned int NativeWidth = 320;
+const unsigned int NativeHeight = 180;
+
+sf::Texture createLayerTexture(unsigned int width, unsigned int height, sf::Uint8 alpha)
+{
+    sf::Image image;
+    image.create(width, height);
+    for (unsigned int y = 0; y < height; y++)
+    {
+        for (unsigned int x = 0; x < width; x++)
+        {
+            auto c = static_cast<sf::Uint8>(((x / 8 + y / 8) % 2) ? 200 : 60);
+            image.setPixel(x, y, sf::Color(c, static_cast<sf::Uint8>(x), static_cast<sf::Uint8>(y), alpha));
+        }
+    }
+    sf::Texture texture;
+    texture.loadFromImage(image);
+    return texture;
+}
+
+// draws a room like scene: an opaque background, translucent parallax layers and a few actors
+void drawScene(sf::RenderTarget &target, const sf::Texture &background, const sf::Texture &layer, int layers, int frame)
+{
+    sf::Sprite sprite(background);
+    target.draw(sprite);
+    for (int i = 0; i < layers; i++)
+    {
+        sf::Sprite layerSprite(layer);
+        layerSprite.setPosition(-static_cast<float>((frame + i * 7) % 32), 0);
+        target.draw(layerSprite);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        sf::Sprite actor(layer, sf::IntRect(0, 0, 32, 64));
+        actor.setPosition(static_cast<float>((i * 40 + frame) % NativeWidth), 100.f);
+        target.draw(actor);
+    }
+}
+
+double runWindow(sf::RenderWindow &window, const sf::Texture &background, const sf::Texture &layer, int layers, int frames)
+{
+    window.setView(sf::View(sf::FloatRect(0, 0, NativeWidth, NativeHeight)));
+    sf::Clock clock;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        window.clear();
+        drawScene(window, background, layer, layers, frame);
+        window.display();
+    }
+    return clock.getElapsedTime().asSeconds() * 1000.0 / frames;
+}
+
+double runNative(sf::RenderWindow &window, const sf::Texture &background, const sf::Texture &layer, int layers, int frames,
+                 bool integerScaling)
+{
+    sf::RenderTexture renderTexture;
+    if (!renderTexture.create(NativeWidth, NativeHeight))
+    {
+        std::cerr << "Failed to create render texture" << std::endl;
+        return 0;
+    }
+
+    auto windowSize = sf::Vector2f(window.getSize());
+    auto scale = sf::Vector2f(windowSize.x / NativeWidth, windowSize.y / NativeHeight);
+    if (integerScaling)
+    {
+        auto factor = std::max(1.f, std::floor(std::min(scale.x, scale.y)));
+        scale = sf::Vector2f(factor, factor);
+    }
+    sf::Sprite screen(renderTexture.getTexture());
+    screen.setScale(scale);
+    screen.setPosition(std::floor((windowSize.x - NativeWidth * scale.x) / 2.f),
+                       std::floor((windowSize.y - NativeHeight * scale.y) / 2.f));
+    window.setView(sf::View(sf::FloatRect(0, 0, windowSize.x, windowSize.y)));
+
+    sf::Clock clock;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        renderTexture.clear();
+        drawScene(renderTexture, background, layer, layers, frame);
+        renderTexture.display();
+
+        window.clear();
+        window.draw(screen);
+        window.display();
+    }
+    return clock.getElapsedTime().asSeconds() * 1000.0 / frames;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? std::atoi(argv[1]) : 300;
+    int layers = argc > 2 ? std::atoi(argv[2]) : 4;
+
+    sf::RenderWindow window(sf::VideoMode(1024, 768), "Render target benchmark");
+    window.setVerticalSyncEnabled(false);
+    window.setFramerateLimit(0);
+
+    auto background = createLayerTexture(NativeWidth + 32, NativeHeight, 255);
+    auto layer = createLayerTexture(NativeWidth + 32, NativeHeight, 128);
+
+    // warm up the driver before measuring
+    runWindow(window, background, layer, layers, 10);
+
+    auto windowTime = runWindow(window, background, layer, layers, frames);
+    auto nativeTime = runNative(window, background, layer, layers, frames, false);
+    auto integerTime = runNative(window, background, layer, layers, frames, true);
+
+    std::cout << "frames: " << frames << ", layers: " << layers << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "window:  " << windowTime << " ms/frame" << std::endl;
+    std::cout << "native:  " << nativeTime << " ms/frame" << std::endl;
+    std::cout << "integer: " << integerTime << " ms/frame" << std::endl;
+    return 0;
+}
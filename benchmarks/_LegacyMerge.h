@@ -0,0 +1,116 @@
+#pragma once
+#include <algorithm>
+#include <list>
+#include <vector>
+#include "Walkbox.h"
+
+// The merge of the walkboxes used by the engine before the hashed union of their edges,
+// kept unchanged as the reference of the outlines checked by mergeCheck.
+namespace ng
+{
+static bool legacyMerge(const ng::Walkbox &w1, const ng::Walkbox &w2, std::vector<sf::Vector2i> &result)
+{
+    // I know this implementation is ugly :S
+    sf::Vector2i v11, v12, v21, v22;
+    bool hasMerged = false;
+    for (int i1 = 0; i1 < w1.getVertices().size(); i1++)
+    {
+        v11 = w1.getVertex(i1);
+        v12 = w1.getVertex((i1 + 1) % w1.getVertices().size());
+        int iShared = -1;
+        for (int i2 = w2.getVertices().size() - 1; i2 >= 0; i2--)
+        {
+            v21 = w2.getVertex(i2);
+            auto i22 = i2;
+            if (i22 == 0)
+                i22 = w2.getVertices().size();
+            v22 = w2.getVertex(i22 - 1);
+            if (v11 == v21 && v12 == v22)
+            {
+                hasMerged = true;
+                iShared = i2;
+                break;
+            }
+        }
+        if (iShared == -1)
+        {
+            result.push_back(v11);
+        }
+        else
+        {
+            for (int i2 = iShared; i2 < w2.getVertices().size() + iShared; i2++)
+            {
+                auto i2p = i2 % w2.getVertices().size();
+                auto i2p2 = (i2p + 1) % w2.getVertices().size();
+                v21 = w2.getVertex(i2p);
+                v22 = w2.getVertex(i2p2);
+
+                int iShared2 = -1;
+                for (auto i1p = i1 + 2; i1p < w1.getVertices().size(); i1p++)
+                {
+                    v11 = w1.getVertex(i1p % w1.getVertices().size());
+                    v12 = w1.getVertex((i1p + 1) % w1.getVertices().size());
+                    if (v21 == v12 && v22 == v11)
+                    {
+                        iShared2 = i1p;
+                        break;
+                    }
+                }
+                if (iShared2 != -1)
+                {
+                    i1 = iShared2;
+                    break;
+                }
+                else
+                {
+                    result.push_back(v21);
+                }
+            }
+        }
+    }
+    return hasMerged;
+}
+
+static void legacyMerge(const std::vector<ng::Walkbox> &walkboxes, std::vector<Walkbox> &result)
+{
+    ng::Walkbox w;
+    std::list<int> walkboxesProcessed;
+    for (int i = 0; i < walkboxes.size(); i++)
+    {
+        if (walkboxes[i].isEnabled())
+        {
+            w = walkboxes[i];
+            break;
+        }
+    }
+
+    if (w.getVertices().empty())
+        return;
+
+    for (int i = 0; i < walkboxes.size(); i++)
+    {
+        if (std::find(walkboxesProcessed.begin(), walkboxesProcessed.end(), i) != walkboxesProcessed.end())
+            continue;
+
+        if (!walkboxes[i].isEnabled())
+            continue;
+
+        std::vector<sf::Vector2i> vertices;
+        if (legacyMerge(w, walkboxes[i], vertices))
+        {
+            w = ng::Walkbox(vertices);
+            walkboxesProcessed.push_back(i);
+            i = -1;
+        }
+    }
+    result.push_back(w);
+
+    for (int i = 0; i < walkboxes.size(); i++)
+    {
+        if (std::find(walkboxesProcessed.begin(), walkboxesProcessed.end(), i) != walkboxesProcessed.end())
+            continue;
+
+        result.push_back(walkboxes[i]);
+    }
+}
+} // namespace ng
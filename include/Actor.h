@@ -68,7 +68,7 @@ public:
 
   void setVolume(float volume);
 
-  void trigSound(const std::string &name) override;
+  void trigSound(int soundTrigger) override;
 
   void drawForeground(sf::RenderTarget &target, sf::RenderStates states) const override;
 
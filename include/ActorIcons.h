@@ -1,5 +1,7 @@
 #pragma once
+#include <optional>
 #include "SFML/Graphics.hpp"
+#include "SpriteBatch.h"
 #include "SpriteSheet.h"
 #include "ActorIconSlot.h"
 #include "Verb.h"
@@ -18,11 +20,28 @@ public:
   void setMousePosition(const sf::Vector2f &pos);
   void update(const sf::Time &elapsed);
   bool isMouseOver() const { return _isInside; }
+  bool isAnimating() const { return _position < 1; }
 
 private:
-  void drawActorIcon(sf::RenderTarget &target, const std::string &icon, int actorSlot, const sf::Vector2f &offset, sf::Uint8 alpha) const;
-  void drawActorIcon(sf::RenderTarget &target, const std::string &icon, sf::Color backColor, sf::Color frameColor, const sf::Vector2f &offset, sf::Uint8 alpha) const;
+  struct State
+  {
+    const Actor *pCurrentActor{nullptr};
+    bool isInside{false};
+    float position{0};
+    sf::Vector2f screen;
+    std::array<const Actor *, 6> actors{};
+    std::array<std::string, 6> icons;
+    std::array<sf::Color, 6> backColors;
+    std::array<sf::Color, 6> frameColors;
+
+    bool operator==(const State &other) const;
+  };
+
+private:
+  void addActorIcon(const std::string &icon, int actorSlot, const sf::Vector2f &offset, sf::Uint8 alpha) const;
+  void addActorIcon(const std::string &icon, sf::Color backColor, sf::Color frameColor, const sf::Vector2f &offset, sf::Uint8 alpha) const;
   void draw(sf::RenderTarget &target, sf::RenderStates states) const override;
+  void updateBatch(const State &state) const;
   int getCurrentActorIndex() const;
   int getIconsNum() const;
   float getOffsetY(int num) const;
@@ -38,5 +57,7 @@ private:
   bool _isInside;
   float _position;
   bool _isMouseButtonPressed;
+  mutable std::optional<State> _state;
+  mutable SpriteBatch _batch;
 };
 } // namespace ng
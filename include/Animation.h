@@ -2,21 +2,17 @@
 #include <optional>
 #include "SFML/Graphics.hpp"
 #include "NonCopyable.h"
+#include "AnimationSystem.h"
 
 namespace ng
 {
 class Object;
 
-enum class AnimState
-{
-  Pause,
-  Play
-};
-
-class Animation : public sf::Drawable
+// The playback state of the animation is stored in the animation system of its room.
+class Animation : public sf::Drawable, public AnimationListener, public NonCopyable
 {
 public:
-  explicit Animation(const sf::Texture &texture, std::string name);
+  Animation(AnimationSystem &animationSystem, const sf::Texture &texture, std::string name);
   ~Animation() override;
 
   void setName(const std::string &name) { _name = name; }
@@ -27,14 +23,12 @@ public:
   std::vector<sf::IntRect> &getSourceRects() { return _sourceRects; }
   std::vector<std::optional<int>> &getTriggers() { return _triggers; }
 
-  void setFps(int fps) { _fps = fps; }
-
-  void update(const sf::Time &elapsed);
+  void setFps(int fps) { _animationSystem.setFps(_track, fps); }
 
   void reset();
   void play(bool loop = false);
-  void pause() { _state = AnimState::Pause; }
-  bool isPlaying() const { return _state == AnimState::Play; }
+  void pause() { _animationSystem.pause(_track); }
+  bool isPlaying() const { return _animationSystem.isPlaying(_track); }
 
   sf::Sprite &getSprite() { return _sprite; }
   const sf::Sprite &getSprite() const { return _sprite; }
@@ -43,20 +37,19 @@ public:
 
 private:
   void draw(sf::RenderTarget &target, sf::RenderStates states) const override;
-  void updateTrigger();
+  void onAnimationEvent(const AnimationEvent &event) override;
+  void updateFrame(int index);
+  void updateTrigger(int index);
 
 private:
+  AnimationSystem &_animationSystem;
+  AnimationTrack _track;
   sf::Sprite _sprite;
   std::string _name;
   std::vector<sf::IntRect> _rects;
   std::vector<sf::Vector2i> _sizes;
   std::vector<sf::IntRect> _sourceRects;
   std::vector<std::optional<int>> _triggers;
-  int _fps;
-  sf::Time _time;
-  size_t _index;
-  AnimState _state;
-  bool _loop{false};
   Object *_pObject{nullptr};
 };
 } // namespace ng
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "SFML/System.hpp"
+#include "NonCopyable.h"
+
+namespace ng
+{
+using AnimationTrack = std::size_t;
+
+struct AnimationEvent
+{
+  AnimationTrack track;
+  // index of the new frame
+  int index;
+  // true when the track reached its last frame and stopped
+  bool finished;
+};
+
+class AnimationListener
+{
+public:
+  virtual ~AnimationListener() = default;
+  virtual void onAnimationEvent(const AnimationEvent &event) = 0;
+};
+
+// Advances the playback state of many animations in one pass.
+// The state of each animation is stored in contiguous arrays indexed by its track,
+// the listeners are notified of the frame changes once all the tracks have been updated.
+class AnimationSystem : public NonCopyable
+{
+public:
+  AnimationSystem();
+  ~AnimationSystem();
+
+  AnimationTrack add(AnimationListener *pListener);
+  void remove(AnimationTrack track);
+
+  void setFrameCount(AnimationTrack track, int count);
+  void setFps(AnimationTrack track, int fps);
+  int getFps(AnimationTrack track) const { return _fps[track]; }
+  void setIndex(AnimationTrack track, int index) { _indices[track] = index; }
+  int getIndex(AnimationTrack track) const { return _indices[track]; }
+  void setLoop(AnimationTrack track, bool loop);
+  void play(AnimationTrack track);
+  void pause(AnimationTrack track);
+  bool isPlaying(AnimationTrack track) const { return (_flags[track] & Playing) != 0; }
+  // restores the frame index and the elapsed time of the track
+  void rewind(AnimationTrack track, int index);
+
+  void update(const sf::Time &elapsed);
+
+  const std::vector<AnimationEvent> &getEvents() const { return _events; }
+
+private:
+  enum Flags : uint8_t
+  {
+    Playing = 1,
+    Loop = 2,
+  };
+
+  void updateRate(AnimationTrack track);
+  void advance(AnimationTrack track);
+
+private:
+  std::vector<float> _times;
+  std::vector<float> _frameTimes;
+  // 1 when the track is advancing, 0 otherwise
+  std::vector<float> _rates;
+  std::vector<int32_t> _indices;
+  std::vector<int32_t> _frameCounts;
+  std::vector<int32_t> _fps;
+  std::vector<uint8_t> _flags;
+  std::vector<AnimationListener *> _listeners;
+  std::vector<AnimationTrack> _freeTracks;
+  std::vector<AnimationTrack> _removedTracks;
+  std::vector<AnimationEvent> _events;
+};
+} // namespace ng
@@ -1,10 +1,11 @@
 #pragma once
 #include <sstream>
+#include <map>
 #include <set>
 #include "SFML/Graphics.hpp"
 #include "NonCopyable.h"
 #include "EngineSettings.h"
-#include "TextureManager.h"
+#include "CostumeManager.h"
 #include "CostumeAnimation.h"
 
 namespace ng
@@ -22,7 +23,7 @@ class Actor;
 class Costume : public sf::Drawable
 {
 public:
-  explicit Costume(TextureManager &textureManager);
+  Costume(CostumeManager &costumeManager, AnimationSystem &animationSystem);
   ~Costume() override;
 
   void loadCostume(const std::string &name, const std::string &sheet = "");
@@ -31,26 +32,25 @@ public:
   Facing getFacing() const { return _facing; }
   void setState(const std::string &name);
   bool setAnimation(const std::string &name);
-  CostumeAnimation *getAnimation() { return _pCurrentAnimation.get(); }
+  CostumeAnimation *getAnimation() { return _pCurrentAnimation; }
+  const std::shared_ptr<const CostumeDefinition> &getDefinition() const { return _pDefinition; }
   void setLayerVisible(const std::string &name, bool isVisible);
   void setHeadIndex(int index);
 
   void setAnimationNames(const std::string &headAnim, const std::string &standAnim, const std::string &walkAnim, const std::string &reachAnim);
   void setActor(Actor *pActor) { _pActor = pActor; }
 
-  void update(const sf::Time &elapsed);
-
 private:
   void draw(sf::RenderTarget &target, sf::RenderStates states) const override;
   void updateAnimation();
 
 private:
-  EngineSettings &_settings;
-  TextureManager &_textureManager;
-  std::string _path;
-  std::string _sheet;
-  std::unique_ptr<CostumeAnimation> _pCurrentAnimation;
-  sf::Texture _texture;
+  CostumeManager &_costumeManager;
+  AnimationSystem &_animationSystem;
+  std::shared_ptr<const CostumeDefinition> _pDefinition;
+  // animations already played by this costume, reset and reused when played again
+  std::map<const CostumeAnimationDefinition *, std::unique_ptr<CostumeAnimation>> _animations;
+  CostumeAnimation *_pCurrentAnimation;
   Facing _facing;
   std::string _animation;
   std::set<std::string> _hiddenLayers;
@@ -2,6 +2,7 @@
 #include <sstream>
 #include "SFML/Graphics.hpp"
 #include "CostumeLayer.h"
+#include "NonCopyable.h"
 
 namespace ng
 {
@@ -11,30 +12,33 @@ enum class AnimationState
   Play
 };
 
-class CostumeAnimation : public sf::Drawable
+class CostumeAnimation : public sf::Drawable, public AnimationListener, public NonCopyable
 {
 public:
-  explicit CostumeAnimation(std::string name);
-  ~CostumeAnimation();
+  CostumeAnimation(const CostumeAnimationDefinition &definition, AnimationSystem &animationSystem);
+  ~CostumeAnimation() override;
 
-  const std::string &getName() const { return _name; }
-  std::vector<CostumeLayer *> &getLayers() { return _layers; }
+  const std::string &getName() const { return _pDefinition->name; }
+  std::vector<CostumeLayer> &getLayers() { return _layers; }
+
+  // restores the initial playback state of the animation and its layers
+  void reset();
 
   void play(bool loop = false);
-  void pause() { _state = AnimationState::Pause; }
+  void pause();
   bool isPlaying() const { return _state == AnimationState::Play; }
   void setFps(int fps);
 
   bool contains(const sf::Vector2f& pos) const;
 
-  void update(const sf::Time &elapsed);
-
 private:
   void draw(sf::RenderTarget &target, sf::RenderStates states) const override;
+  void onAnimationEvent(const AnimationEvent &event) override;
 
 private:
-  std::string _name;
-  std::vector<CostumeLayer *> _layers;
+  const CostumeAnimationDefinition *_pDefinition;
+  AnimationSystem &_animationSystem;
+  std::vector<CostumeLayer> _layers;
   AnimationState _state;
   bool _loop;
 };
@@ -0,0 +1,76 @@
+#pragma once
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include "SFML/Graphics.hpp"
+
+namespace ng
+{
+// Immutable data of a costume layer with the frames resolved from the sprite sheet.
+struct CostumeLayerDefinition
+{
+  std::string name;
+  int fps{10};
+  int flags{0};
+  std::vector<sf::IntRect> frames;
+  std::vector<sf::IntRect> sourceFrames;
+  std::vector<sf::Vector2i> sizes;
+  std::vector<sf::Vector2i> offsets;
+  std::vector<std::optional<int>> triggers;
+  // index of the sound in the sound triggers of the costume
+  std::vector<std::optional<int>> soundTriggers;
+};
+
+struct CostumeAnimationDefinition
+{
+  std::string name;
+  std::vector<CostumeLayerDefinition> layers;
+};
+
+// A costume compiled once from its costume file and sprite sheet, shared by all the actors using it.
+class CostumeDefinition
+{
+public:
+  CostumeDefinition(std::string sheet, const sf::Texture &texture)
+      : _sheet(std::move(sheet)), _pTexture(&texture)
+  {
+  }
+
+  const std::string &getSheet() const { return _sheet; }
+  const sf::Texture &getTexture() const { return *_pTexture; }
+
+  void addAnimation(CostumeAnimationDefinition animation)
+  {
+    auto name = animation.name;
+    _animations[name] = std::move(animation);
+  }
+
+  const CostumeAnimationDefinition *getAnimation(const std::string &name) const
+  {
+    auto it = _animations.find(name);
+    if (it == _animations.end())
+      return nullptr;
+    return &it->second;
+  }
+
+  int addSoundTrigger(const std::string &name)
+  {
+    auto it = std::find(_soundTriggers.begin(), _soundTriggers.end(), name);
+    if (it != _soundTriggers.end())
+      return static_cast<int>(std::distance(_soundTriggers.begin(), it));
+    _soundTriggers.push_back(name);
+    return static_cast<int>(_soundTriggers.size() - 1);
+  }
+
+  // names of the sounds played by the layers, resolved by the actors when they load the costume
+  const std::vector<std::string> &getSoundTriggers() const { return _soundTriggers; }
+
+private:
+  std::string _sheet;
+  const sf::Texture *_pTexture;
+  std::map<std::string, CostumeAnimationDefinition> _animations;
+  std::vector<std::string> _soundTriggers;
+};
+} // namespace ng
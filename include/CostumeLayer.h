@@ -2,62 +2,62 @@
 #include <sstream>
 #include <optional>
 #include "SFML/Graphics.hpp"
+#include "AnimationSystem.h"
+#include "CostumeDefinition.h"
 
 namespace ng
 {
 class Actor;
 
+// A layer of a costume animation, the frames are shared with the costume definition
+// and the playback state is stored in a track of the animation system.
 class CostumeLayer : public sf::Drawable
 {
 public:
-  CostumeLayer();
+  CostumeLayer(const CostumeLayerDefinition &definition, AnimationSystem &animationSystem, AnimationTrack track);
   ~CostumeLayer();
 
-  std::vector<sf::IntRect> &getFrames() { return _frames; }
-  std::vector<sf::IntRect> &getSourceFrames() { return _sourceFrames; }
-  std::vector<sf::Vector2i> &getSizes() { return _sizes; }
-  std::vector<sf::Vector2i> &getOffsets() { return _offsets; }
-
-  void setName(const std::string &name) { _name = name; }
-  const std::string &getName() const { return _name; }
-  int getFps() const { return _fps; }
-  void setFps(int fps) { _fps = fps; }
-  int getFlags() const { return _flags; }
-  void setFlags(int flags) { _flags = flags; }
-  int getIndex() const { return _index; }
+  // restores the initial playback state
+  void reset();
+
+  const std::vector<sf::IntRect> &getFrames() const { return _pDefinition->frames; }
+  const std::vector<sf::IntRect> &getSourceFrames() const { return _pDefinition->sourceFrames; }
+  const std::vector<sf::Vector2i> &getSizes() const { return _pDefinition->sizes; }
+  const std::vector<sf::Vector2i> &getOffsets() const { return _pDefinition->offsets; }
+
+  const std::string &getName() const { return _pDefinition->name; }
+  AnimationTrack getTrack() const { return _track; }
+  int getFps() const { return _pAnimationSystem->getFps(_track); }
+  void setFps(int fps) { _pAnimationSystem->setFps(_track, fps); }
+  int getFlags() const { return _pDefinition->flags; }
+  int getIndex() const { return _pAnimationSystem->getIndex(_track); }
   void setVisible(bool isVisible) { _isVisible = isVisible; }
   int getVisible() const { return _isVisible; }
-  std::vector<std::optional<int>> &getTriggers() { return _triggers; }
-  std::vector<std::optional<std::string>> &getSoundTriggers() { return _soundTriggers; }
+  const std::vector<std::optional<int>> &getTriggers() const { return _pDefinition->triggers; }
+  const std::vector<std::optional<int>> &getSoundTriggers() const { return _pDefinition->soundTriggers; }
   void setActor(Actor *pActor) { _pActor = pActor; }
-  void setLoop(bool loop) { _loop = loop; }
-  void setTexture(sf::Texture *pTexture) { _pTexture = pTexture; }
+  void setLoop(bool loop) { _pAnimationSystem->setLoop(_track, loop); }
+  void play() { _pAnimationSystem->play(_track); }
+  void pause() { _pAnimationSystem->pause(_track); }
+  bool isPlaying() const { return _pAnimationSystem->isPlaying(_track); }
+  void setTexture(const sf::Texture *pTexture) { _pTexture = pTexture; }
   void setLeftDirection(bool leftDirection) { _leftDirection = leftDirection; }
   bool contains(const sf::Vector2f& pos) const;
 
-  bool update(const sf::Time &elapsed);
+  void onFrameChanged(int index);
 
 private:
   void draw(sf::RenderTarget &target, sf::RenderStates states) const override;
-  void updateTrigger();
-  void updateSoundTrigger();
+  void updateTrigger(int index);
+  void updateSoundTrigger(int index);
 
 private:
-  std::string _name;
-  std::vector<sf::IntRect> _frames;
-  std::vector<sf::IntRect> _sourceFrames;
-  std::vector<sf::Vector2i> _sizes;
-  std::vector<sf::Vector2i> _offsets;
-  std::vector<std::optional<int>> _triggers;
-  std::vector<std::optional<std::string>> _soundTriggers;
-  sf::Texture *_pTexture;
-  int _fps;
-  int _flags;
-  sf::Time _time;
-  int _index;
+  const CostumeLayerDefinition *_pDefinition;
+  AnimationSystem *_pAnimationSystem;
+  AnimationTrack _track;
+  const sf::Texture *_pTexture;
   bool _isVisible;
   Actor *_pActor;
-  bool _loop;
   bool _leftDirection;
 };
-} // namespace ng
\ No newline at end of file
+} // namespace ng
@@ -0,0 +1,26 @@
+#pragma once
+#include <map>
+#include <memory>
+#include "CostumeDefinition.h"
+#include "NonCopyable.h"
+#include "TextureManager.h"
+
+namespace ng
+{
+class CostumeManager : public NonCopyable
+{
+private:
+  std::map<std::string, std::shared_ptr<const CostumeDefinition>> _definitions;
+  TextureManager &_textureManager;
+
+public:
+  explicit CostumeManager(TextureManager &textureManager);
+  ~CostumeManager();
+
+  std::shared_ptr<const CostumeDefinition> get(const std::string &path, const std::string &sheet);
+  TextureManager &getTextureManager() { return _textureManager; }
+
+private:
+  std::shared_ptr<const CostumeDefinition> load(const std::string &path, const std::string &sheet);
+};
+} // namespace ng
@@ -8,6 +8,9 @@
 namespace ng
 {
 class Actor;
+class AnimationSystem;
+class CostumeManager;
+class LipTable;
 class Cutscene;
 class DialogManager;
 class EngineSettings;
@@ -20,9 +23,12 @@ class ScriptExecute;
 class SoundDefinition;
 class SoundManager;
 class TextureManager;
+class ThreadPool;
 struct Verb;
 class VerbExecute;
 
+enum class PathFinderMode;
+
 enum class CursorDirection
 {
   None = 0,
@@ -54,8 +60,18 @@ public:
 
   void setWindow(sf::RenderWindow &window);
   const sf::RenderWindow& getWindow() const;
+  // view of the virtual screen of the current room, the window view isn't used by the engine
+  const sf::View &getView() const;
+  // area of the window where the screen is displayed, used to map the mouse position
+  void setViewport(const sf::FloatRect &viewport);
 
   TextureManager &getTextureManager();
+  CostumeManager &getCostumeManager();
+  // animates the costumes of the actors
+  AnimationSystem &getAnimationSystem();
+  LipTable &getLipTable();
+  // runs the background jobs, like the path queries
+  ThreadPool &getThreadPool();
   EngineSettings &getSettings();
 
   Room *getRoom();
@@ -69,6 +85,10 @@ public:
   void addActor(std::unique_ptr<Actor> actor);
   void addRoom(std::unique_ptr<Room> room);
   const std::vector<std::unique_ptr<Room>> &getRooms() const;
+  // precomputes the shortest paths of the walk graph of the rooms entered
+  void setPrecomputedPaths(bool enabled);
+  // path finder used by the rooms, including the ones added later
+  void setPathFinderMode(PathFinderMode mode);
   void addFunction(std::unique_ptr<Function> function);
   void cutscene(std::unique_ptr<Cutscene> function);
   bool inCutscene() const;
@@ -77,7 +97,14 @@ public:
   std::vector<std::unique_ptr<Actor>> &getActors();
 
   void update(const sf::Time &elapsed);
-  void draw(sf::RenderWindow &window) const;
+  void draw(sf::RenderTarget &target) const;
+  void showRenderStats(bool show);
+  bool areRenderStatsVisible() const;
+  // indicates if the last update changed something on screen
+  bool isSceneDirty() const;
+  // position of the rendering between the previous and the last update, from 0 to 1
+  void setRenderInterpolation(float alpha);
+  float getRenderInterpolation() const;
   int getFrameCounter() const;
 
   void setCurrentActor(Actor *pCurrentActor);
@@ -126,6 +153,9 @@ public:
 
   HSQOBJECT& getDefaultObject();
 
+ private:
+  void drawScene(sf::RenderTarget &target) const;
+
  private:
   struct Impl;
   std::unique_ptr<Impl> _pImpl;
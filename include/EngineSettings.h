@@ -26,6 +26,12 @@ public:
     return _pack1.hasEntry(name) || _pack2.hasEntry(name);
   }
 
+  void getEntries(std::vector<std::string> &names) const
+  {
+    _pack1.getEntries(names);
+    _pack2.getEntries(names);
+  }
+
   void readEntry(const std::string &name, std::vector<char> &data)
   {
     if (_pack1.hasEntry(name))
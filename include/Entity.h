@@ -32,7 +32,7 @@ public:
   void setTrigger(int triggerNumber, std::shared_ptr<Trigger> trigger);
   void trig(int triggerNumber);
 
-  virtual void trigSound(const std::string &name);
+  virtual void trigSound(int soundTrigger);
   virtual void drawForeground(sf::RenderTarget &target, sf::RenderStates states) const;
 
   virtual Room *getRoom() = 0;
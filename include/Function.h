@@ -11,6 +11,8 @@ class Function : public NonCopyable
 {
 public:
   virtual bool isElapsed() { return true; }
+  // true when the function only waits for a condition and doesn't change the scene
+  virtual bool isIdle() { return false; }
   virtual void operator()(const sf::Time &elapsed) {}
   virtual ~Function() = default;
 };
@@ -118,6 +118,7 @@ public:
 
   void open(const std::string &path);
   bool hasEntry(const std::string &name);
+  void getEntries(std::vector<std::string> &names) const;
   void readEntry(const std::string &name, std::vector<char> &data);
   void readHashEntry(const std::string &name, GGPackValue &value);
 
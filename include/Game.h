@@ -15,6 +15,16 @@ public:
   virtual ~InputEventHandler() = default;
 };
 
+enum class RenderMode
+{
+  // draws the scene directly into the window
+  Window,
+  // draws the scene at native resolution, then stretches it to the window with nearest filtering
+  Native,
+  // draws the scene at native resolution, then upscales it by the largest integer factor (letterboxed)
+  NativeInteger
+};
+
 class Game : public NonCopyable
 {
 public:
@@ -25,13 +35,37 @@ public:
   sf::RenderWindow &getWindow() { return _window; }
   std::vector<std::unique_ptr<InputEventHandler>> &getInputEventHandlers() { return _inputEventHandlers; }
 
+  void setRenderMode(RenderMode mode) { _renderMode = mode; }
+  RenderMode getRenderMode() const { return _renderMode; }
+
+  // when enabled, frames are not rendered again while the scene doesn't change
+  void setIdleFrameSkipping(bool enabled) { _idleFrameSkipping = enabled; }
+  bool getIdleFrameSkipping() const { return _idleFrameSkipping; }
+
+  // the simulation is updated with a fixed timestep of 1/ticksPerSecond, clamped to 1..1000
+  void setTickRate(int ticksPerSecond);
+  // maximum number of updates done in a frame to catch up, the remaining time is dropped
+  void setMaxTicksPerFrame(unsigned int maxTicks) { _maxTicksPerFrame = maxTicks; }
+
+  static RenderMode parseRenderMode(const std::string &mode);
+
 private:
-  void processEvents();
+  bool processEvents();
   void update(const sf::Time &time);
+  void updateTicks(const sf::Time &elapsed);
   void render();
+  void renderNative();
 
   Engine &_engine;
   sf::RenderWindow _window;
+  sf::RenderTexture _renderTexture;
+  RenderMode _renderMode{RenderMode::Window};
+  bool _idleFrameSkipping{true};
+  sf::Clock _presentClock;
+  sf::Time _tickTime{sf::seconds(1.f / 60)};
+  sf::Time _accumulator;
+  unsigned int _maxTicksPerFrame{5};
+  bool _isSceneDirty{true};
   std::vector<std::unique_ptr<InputEventHandler>> _inputEventHandlers;
 };
 } // namespace ng
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include "SFML/Graphics.hpp"
@@ -17,6 +18,13 @@ struct GraphEdge
   friend std::ostream &operator<<(std::ostream &os, const GraphEdge &edge);
 };
 
+// Edge of a frozen graph, it starts from the node of its row
+struct GraphArc
+{
+  uint32_t to{0};
+  float cost{0};
+};
+
 /*
  * This class has been ported from http://www.groebelsloot.com/2016/03/13/pathfinding-part-2/
  * and modified
@@ -29,19 +37,27 @@ class Graph : public sf::Drawable
 {
 public:
   std::vector<sf::Vector2i> nodes;
-  std::vector<std::vector<std::shared_ptr<GraphEdge>>> edges;
   std::vector<sf::Vector2i> concaveVertices;
 
 public:
   Graph();
-  Graph(const Graph &graph);
 
-  std::shared_ptr<GraphEdge> getEdge(int from, int to);
   int addNode(sf::Vector2i node);
-  void addEdge(const std::shared_ptr<GraphEdge>& edge);
+  void addEdge(const GraphEdge &edge);
+  // stores the edges added so far in compressed sparse rows, the duplicated edges are removed
+  void freeze();
+
+  const GraphArc *beginEdges(int node) const { return _arcs.data() + _offsets[node]; }
+  const GraphArc *endEdges(int node) const { return _arcs.data() + _offsets[node + 1]; }
+  size_t getEdgeCount() const { return _arcs.size(); }
 
 private:
   void draw(sf::RenderTarget &target, sf::RenderStates states) const override;
+
+private:
+  std::vector<GraphEdge> _edges;
+  std::vector<uint32_t> _offsets{0};
+  std::vector<GraphArc> _arcs;
 };
 
 class Path : public sf::Drawable
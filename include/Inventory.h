@@ -1,8 +1,10 @@
 #pragma once
 #include <array>
+#include <optional>
 #include "SFML/Graphics.hpp"
 #include "ActorIconSlot.h"
 #include "Verb.h"
+#include "SpriteBatch.h"
 #include "SpriteSheet.h"
 
 namespace ng
@@ -22,10 +24,24 @@ public:
   void setMousePosition(const sf::Vector2f &pos) { _mousePos = pos; }
   const InventoryObject *getCurrentInventoryObject() const { return _pCurrentInventoryObject; }
 
+private:
+  struct State
+  {
+    int actorIndex{-1};
+    sf::Vector2f screen;
+    sf::Color background;
+    sf::Color arrows;
+    // icon per visible slot, an object can be destroyed and another allocated at the same address
+    std::vector<std::string> icons;
+
+    bool operator==(const State &other) const;
+  };
+
 private:
   void draw(sf::RenderTarget &target, sf::RenderStates states) const override;
-  void drawUpArrow(sf::RenderTarget &target) const;
-  void drawDownArrow(sf::RenderTarget &target) const;
+  void updateBatches(const State &state) const;
+  void addUpArrow(const State &state) const;
+  void addDownArrow(const State &state) const;
 
 private:
   int getCurrentActorIndex() const;
@@ -39,5 +55,8 @@ private:
   sf::IntRect _inventoryRects[8];
   const InventoryObject *_pCurrentInventoryObject;
   sf::Vector2f _mousePos;
+  mutable std::optional<State> _state;
+  mutable SpriteBatch _backgroundBatch;
+  mutable SpriteBatch _itemsBatch;
 };
 } // namespace ng
@@ -1,7 +1,10 @@
 #pragma once
+#include <map>
+#include <memory>
 #include <vector>
 #include "SFML/System.hpp"
 #include "EngineSettings.h"
+#include "NonCopyable.h"
 
 // see https://github.com/DanielSWolf/rhubarb-lip-sync for more details
 
@@ -14,18 +17,39 @@ public:
   char letter;
 };
 
+using NGLipTrack = std::vector<NGLipData>;
+
+// Lip tracks already parsed, keyed by voice line.
+// The table can be saved to a binary file to skip the parsing of the .lip files.
+class LipTable : public NonCopyable
+{
+public:
+  std::shared_ptr<const NGLipTrack> get(const std::string &name) const;
+  void add(const std::string &name, std::shared_ptr<const NGLipTrack> track);
+
+  bool load(const std::string &path);
+  bool save(const std::string &path) const;
+  bool isModified() const { return _isModified; }
+
+private:
+  std::map<std::string, std::shared_ptr<const NGLipTrack>> _tracks;
+  bool _isModified{false};
+};
+
 class Lip
 {
 public:
   Lip();
   void setSettings(EngineSettings &settings);
+  void setTable(LipTable *pTable) { _pTable = pTable; }
   void load(const std::string &path);
-  const std::vector<NGLipData> getData() const { return _data; }
+  const NGLipTrack &getData() const { return *_data; }
   std::string getPath() const { return _path; }
 
 private:
   EngineSettings* _pSettings;
+  LipTable *_pTable;
   std::string _path;
-  std::vector<NGLipData> _data;
+  std::shared_ptr<const NGLipTrack> _data;
 };
 } // namespace ng
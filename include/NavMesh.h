@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "Walkbox.h"
+
+namespace ng
+{
+// Triangulation of the enabled walkboxes, the triangles of touching walkboxes are linked.
+// A path is found with an A* search over the triangles, then shortened along the corridor
+// of triangles with the simple stupid funnel algorithm.
+class NavMesh
+{
+public:
+  explicit NavMesh(const std::vector<Walkbox> &walkboxes);
+
+  void calculatePath(const sf::Vector2i &from, const sf::Vector2i &to, std::vector<sf::Vector2i> &path);
+  size_t getTriangleCount() const { return _triangles.size(); }
+
+private:
+  struct Triangle
+  {
+    // counterclockwise
+    std::array<sf::Vector2i, 3> vertices;
+    // triangle on the other side of the edge from the vertex i to the next one, -1 when there is none
+    std::array<int, 3> neighbours{-1, -1, -1};
+    sf::Vector2f centroid;
+  };
+
+  // the aligned vertices are removed unless they are shared with another walkbox
+  void triangulate(std::vector<sf::Vector2i> polygon, std::vector<bool> isShared);
+  void addTriangle(const sf::Vector2i &v1, const sf::Vector2i &v2, const sf::Vector2i &v3);
+  void linkTriangles();
+  int locate(const sf::Vector2i &position) const;
+  bool findCorridor(int start, int end, const sf::Vector2i &to);
+  void trimCorridor(const sf::Vector2i &from, const sf::Vector2i &to);
+  void pullString(const sf::Vector2i &from, const sf::Vector2i &to, std::vector<sf::Vector2i> &path);
+
+private:
+  std::vector<Triangle> _triangles;
+  // search state, kept between the queries
+  std::vector<float> _gCosts;
+  std::vector<float> _fCosts;
+  std::vector<int> _parents;
+  std::vector<int> _queue;
+  std::vector<int> _queuePositions;
+  std::vector<int> _corridor;
+  // left and right vertices of the edges crossed by the corridor
+  std::vector<std::pair<sf::Vector2i, sf::Vector2i>> _portals;
+};
+} // namespace ng
@@ -61,7 +61,7 @@ public:
   void playAnim(const std::string& anim, bool loop);
   int getState();
   void setAnimation(const std::string &name);
-  std::optional<Animation>& getAnimation();
+  Animation *getAnimation();
 
   void setDefaultPosition(const sf::Vector2f &pos);
   sf::Vector2f getDefaultPosition() const override;
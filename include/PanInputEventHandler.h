@@ -3,6 +3,7 @@
 #include "Game.h"
 #include "Engine.h"
 #include "Room.h"
+#include "RenderStats.h"
 
 namespace ng
 {
@@ -93,6 +94,24 @@ class EngineShortcutsInputEventHandler : public InputEventHandler
                 _engine.getRoom()->showDrawWalkboxes(!_engine.getRoom()->areDrawWalkboxesVisible());
                 break;
             }
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::R))
+            {
+                _engine.showRenderStats(!_engine.areRenderStatsVisible());
+                break;
+            }
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::C))
+            {
+                auto &stats = RenderStats::get();
+                if (stats.isCsvActive())
+                {
+                    stats.stopCsv();
+                }
+                else
+                {
+                    stats.startCsv("renderstats.csv");
+                }
+                break;
+            }
             break;
         default:
             break;
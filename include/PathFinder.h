@@ -1,25 +1,70 @@
 #pragma once
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include "Walkbox.h"
 #include "Graph.h"
+#include "NavMesh.h"
+#include "WalkboxGrid.h"
 
 namespace ng
 {
+enum class PathFinderMode
+{
+  // shortest paths over the graph of the concave vertices
+  VisibilityGraph,
+  // paths through the triangles of the walkboxes, straightened with a funnel
+  NavMesh
+};
+
+// The queries can be made from any thread, they are run one at a time.
 class PathFinder
 {
 public:
-  PathFinder(const std::vector<Walkbox> &walkboxes);
+  explicit PathFinder(std::vector<Walkbox> walkboxes, PathFinderMode mode = PathFinderMode::VisibilityGraph);
+  ~PathFinder();
 
   std::vector<sf::Vector2i> calculatePath(sf::Vector2i from, sf::Vector2i to);
-  std::shared_ptr<Graph> getGraph() const { return _graph; }
+  std::shared_ptr<Graph> getGraph() const;
+  const std::vector<Walkbox> &getWalkboxes() const { return _walkboxes; }
+  PathFinderMode getMode() const { return _mode; }
+
+  // Computes the shortest paths between all the concave vertices on a worker thread,
+  // once they are ready a query only links its start and end to the vertices they can see.
+  // In navmesh mode, only builds the navmesh.
+  void precomputePaths();
+  bool hasPrecomputedPaths();
+
+  // the tables grow with the square of the number of vertices, a bigger graph is always searched with A*
+  static constexpr size_t MaxPrecomputedNodes = 1024;
+
+  struct Query;
 
 private:
   std::shared_ptr<Graph> createGraph();
-  bool inLineOfSight(const sf::Vector2i &start, const sf::Vector2i &end);
+  bool updatePrecomputedPaths();
+  bool isWalkable(const sf::Vector2i &position) const;
+  // checks the line of sight between two walkable positions
+  bool isSegmentClear(const sf::Vector2i &start, const sf::Vector2i &end);
   sf::Vector2i getClosestPointOnEdge(const sf::Vector2i &from) const;
 
 private:
+  struct EdgeGrid;
+  struct ShortestPaths;
+
   std::shared_ptr<Graph> _graph;
-  const  std::vector<Walkbox>& _walkboxes;
+  const std::vector<Walkbox> _walkboxes;
+  const PathFinderMode _mode;
+  mutable std::mutex _mutex;
+  std::unique_ptr<Query> _query;
+  std::unique_ptr<EdgeGrid> _edgeGrid;
+  std::unique_ptr<NavMesh> _navMesh;
+  WalkboxGrid _walkboxGrid;
+  std::vector<bool> _walkableVertices;
+  std::future<std::unique_ptr<ShortestPaths>> _pendingPaths;
+  std::unique_ptr<ShortestPaths> _paths;
+  std::atomic<bool> _isCancelled{false};
 };
 } // namespace ng
\ No newline at end of file
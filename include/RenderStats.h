@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+#include <fstream>
+#include <string>
+#include "SFML/Graphics.hpp"
+
+namespace ng
+{
+enum class RenderStatsPhase
+{
+  UpdateFunctions,
+  UpdateRoom,
+  UpdateCurrentObject,
+  UpdateCurrentActor,
+  UpdateInventory,
+  UpdateDialog,
+  Draw,
+  Count
+};
+
+struct RenderFrameStats
+{
+  unsigned int drawCalls{0};
+  unsigned int vertices{0};
+  unsigned int textureSwitches{0};
+  unsigned int spritesCulled{0};
+  unsigned int textureUploads{0};
+  bool presented{false};
+  std::array<sf::Time, static_cast<size_t>(RenderStatsPhase::Count)> times{};
+};
+
+// Counters and CPU timings of the current frame, the last complete frame is kept for the overlay
+// and can be appended to a CSV file.
+class RenderStats
+{
+public:
+  static RenderStats &get();
+
+  void beginFrame();
+  void endFrame();
+
+  void addDrawCall(const sf::Texture *pTexture, std::size_t vertexCount);
+  void addCulledSprite() { _current.spritesCulled++; }
+  void addTextureUpload() { _current.textureUploads++; }
+  void addTime(RenderStatsPhase phase, const sf::Time &time);
+  void setPresented(bool presented);
+
+  unsigned int getFramesPresented() const { return _framesPresented; }
+  unsigned int getFramesSkipped() const { return _framesSkipped; }
+
+  const RenderFrameStats &getLastFrame() const { return _last; }
+  unsigned int getFrameNumber() const { return _frame; }
+
+  bool startCsv(const std::string &path);
+  void stopCsv();
+  bool isCsvActive() const { return _csv.is_open(); }
+
+  static const char *getPhaseName(RenderStatsPhase phase);
+
+private:
+  RenderStats() = default;
+  void writeCsvRow();
+
+private:
+  RenderFrameStats _current;
+  RenderFrameStats _last;
+  const sf::Texture *_pLastTexture{nullptr};
+  unsigned int _frame{0};
+  unsigned int _framesPresented{0};
+  unsigned int _framesSkipped{0};
+  std::ofstream _csv;
+};
+
+// Measures the CPU time of a scope and adds it to the given phase.
+class RenderStatsTimer
+{
+public:
+  explicit RenderStatsTimer(RenderStatsPhase phase) : _phase(phase) {}
+  ~RenderStatsTimer() { RenderStats::get().addTime(_phase, _clock.getElapsedTime()); }
+
+private:
+  RenderStatsPhase _phase;
+  sf::Clock _clock;
+};
+} // namespace ng
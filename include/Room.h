@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include <vector>
 #include "squirrel.h"
 #include "nlohmann/json.hpp"
@@ -9,6 +10,8 @@ namespace ng
 class EngineSettings;
 class Entity;
 class Object;
+class PathFinder;
+enum class PathFinderMode;
 class RoomScaling;
 class TextureManager;
 class TextObject;
@@ -31,13 +34,20 @@ public:
   const std::string &getSheet() const;
 
   void update(const sf::Time &elapsed);
-  void draw(sf::RenderWindow &window, const sf::Vector2f &cameraPos) const;
+  void draw(sf::RenderTarget &target, const sf::Vector2f &cameraPos) const;
 
   void showDrawWalkboxes(bool show);
   bool areDrawWalkboxesVisible() const;
   void setWalkboxEnabled(const std::string &name, bool isEnabled);
   bool inWalkbox(const sf::Vector2f &pos) const;
-  std::vector<sf::Vector2i> calculatePath(const sf::Vector2i &start, const sf::Vector2i &end) const;
+  // path finder of the current walkbox configuration, it can be used from a worker thread
+  std::shared_ptr<PathFinder> getPathFinder() const;
+  // precomputes the shortest paths of each walkbox configuration on a worker thread
+  void setPrecomputedPaths(bool enabled);
+  // the walk graphs of the room are rebuilt with the new path finder
+  void setPathFinderMode(PathFinderMode mode);
+  // number of walkbox toggles which reused the graph of a previous configuration
+  size_t getWalkGraphCacheHits() const;
 
   Object &createObject(const std::string &sheet, const std::vector<std::string> &anims);
   Object &createObject(const std::vector<std::string> &anims);
@@ -57,11 +67,15 @@ public:
   void setAmbientLight(sf::Color color);
   sf::Color getAmbientLight() const;
 
+  // set when something visible changed in the room since the last check
+  void setDirty(bool dirty);
+  bool isDirty() const;
+
   void removeEntity(Entity *pEntity);
   std::vector<RoomScaling>& getScalings();
 
 private:
-  void drawWalkboxes(sf::RenderWindow &window, sf::RenderStates states) const;
+  void drawWalkboxes(sf::RenderTarget &target, sf::RenderStates states) const;
 
 private:
   struct Impl;
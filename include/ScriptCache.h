@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "squirrel.h"
+
+namespace ng
+{
+// Scripts compiled to bytecode, saved in a directory with one file per script.
+// Each file keeps the hash of the script it was compiled from, a script which changed is compiled again.
+class ScriptCache
+{
+public:
+  explicit ScriptCache(std::string directory);
+
+  static uint64_t hash(const std::vector<char> &data);
+
+  // true when the script with this hash has been compiled
+  bool contains(const std::string &name, uint64_t hash) const;
+  // pushes the closure compiled from the script with this hash
+  bool load(HSQUIRRELVM v, const std::string &name, uint64_t hash) const;
+  // saves the closure on top of the stack
+  bool save(HSQUIRRELVM v, const std::string &name, uint64_t hash) const;
+
+private:
+  std::string getPath(const std::string &name) const;
+  static bool readHeader(std::istream &input, uint64_t hash);
+
+private:
+  const std::string _directory;
+};
+} // namespace ng
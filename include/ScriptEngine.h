@@ -4,6 +4,7 @@
 #include "squirrel.h"
 #include "Engine.h"
 #include "Interpolations.h"
+#include "ScriptCache.h"
 
 namespace ng
 {
@@ -30,6 +31,9 @@ public:
   void executeScript(const std::string &name);
   void executeNutScript(const std::string& name);
   void executeBootScript();
+  // Compiles the scripts of the packs missing from the script cache, each one on a worker thread with its own VM,
+  // so the scripts executed after are loaded from the cache.
+  void compileScripts();
 
   template <class TPack>
   void addPack();
@@ -56,6 +60,8 @@ private:
   Engine &_engine;
   HSQUIRRELVM v;
   std::vector<std::unique_ptr<Pack>> _packs;
+  // compiled scripts, kept between the runs
+  ScriptCache _scriptCache{"cache"};
 };
 
 } // namespace ng
\ No newline at end of file
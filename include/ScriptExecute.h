@@ -1,9 +1,22 @@
 #pragma once
+#include <chrono>
+#include <memory>
 #include <string>
 
 namespace ng
 {
 class SoundDefinition;
+
+// executions of code snippets which had to be compiled and which reused the compiled code,
+// a cached snippet runs in less than a microsecond so the times are in nanoseconds
+struct ScriptExecuteStats
+{
+    unsigned int compiles{0};
+    unsigned int cacheHits{0};
+    std::chrono::nanoseconds compileTime{0};
+    std::chrono::nanoseconds cacheHitTime{0};
+};
+
 class ScriptExecute
 {
   public:
@@ -12,5 +25,6 @@ class ScriptExecute
     virtual std::string executeDollar(const std::string &code) = 0;
     virtual bool executeCondition(const std::string &code) = 0;
     virtual std::shared_ptr<SoundDefinition> getSoundDefinition(const std::string &name) = 0;
+    virtual const ScriptExecuteStats &getStats() const = 0;
 };
 }
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+#include "SFML/Graphics.hpp"
+
+namespace ng
+{
+// Retained list of textured quads sharing the same texture, drawn in a single call.
+class SpriteBatch : public sf::Drawable
+{
+public:
+  SpriteBatch();
+
+  void setTexture(const sf::Texture *pTexture) { _pTexture = pTexture; }
+  void clear();
+  bool isEmpty() const { return _vertices.getVertexCount() == 0; }
+
+  void add(const sf::Sprite &sprite);
+  void add(const sf::RectangleShape &shape);
+  void addQuad(const sf::Transform &transform, const sf::Vector2f &size, const sf::IntRect &textureRect, const sf::Color &color);
+
+private:
+  void draw(sf::RenderTarget &target, sf::RenderStates states) const override;
+
+private:
+  const sf::Texture *_pTexture{nullptr};
+  sf::VertexArray _vertices;
+};
+} // namespace ng
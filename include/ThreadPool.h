@@ -0,0 +1,45 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "NonCopyable.h"
+
+namespace ng
+{
+// Runs the submitted jobs on a few worker threads, the jobs which haven't started
+// when the pool is destroyed are dropped and their futures report a broken promise.
+class ThreadPool : public NonCopyable
+{
+public:
+  explicit ThreadPool(size_t threadCount);
+  ~ThreadPool();
+
+  template <typename F>
+  auto submit(F f) -> std::future<decltype(f())>
+  {
+    auto task = std::make_shared<std::packaged_task<decltype(f())()>>(std::move(f));
+    auto future = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _jobs.emplace_back([task]() { (*task)(); });
+    }
+    _condition.notify_one();
+    return future;
+  }
+
+private:
+  void run();
+
+private:
+  std::vector<std::thread> _threads;
+  std::deque<std::function<void()>> _jobs;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  bool _isStopped{false};
+};
+} // namespace ng
@@ -22,6 +22,7 @@ public:
 
   const std::vector<sf::Vector2i> &getVertices() const { return _polygon; }
   const sf::Vector2i &getVertex(size_t index) const { return _polygon[index]; }
+  const sf::IntRect &getBounds() const { return _bounds; }
 
   bool inside(const sf::Vector2i &position, bool toleranceOnOutside = true) const;
   bool isVertexConcave(int vertex) const;
@@ -35,9 +36,11 @@ public:
 private:
   static float distanceToSegmentSquared(const sf::Vector2i &p, const sf::Vector2i &v, const sf::Vector2i &w);
   void draw(sf::RenderTarget &target, sf::RenderStates states) const override;
+  void updateBounds();
 
 private:
   std::vector<sf::Vector2i> _polygon;
+  sf::IntRect _bounds;
   std::string _name;
   bool _isEnabled{true};
   sf::Color _color{sf::Color::Green};
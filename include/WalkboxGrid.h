@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Walkbox.h"
+
+namespace ng
+{
+// Uniform grid over a set of walkboxes to answer the point queries in constant time on average.
+// A cell lists the walkboxes which cover it entirely and the ones with an edge going through it,
+// only the latter need the polygon test.
+class WalkboxGrid
+{
+public:
+  // the walkboxes are referenced, their vertices must not change while the grid is used
+  void build(const std::vector<Walkbox> &walkboxes);
+
+  // indicates if the position is inside one of the walkboxes, the disabled ones are ignored when enabledOnly is true
+  bool inside(const sf::Vector2i &position, bool enabledOnly) const;
+
+private:
+  struct Entry
+  {
+    uint32_t walkbox;
+    bool isOnEdge;
+  };
+
+private:
+  const std::vector<Walkbox> *_pWalkboxes{nullptr};
+  sf::Vector2i _origin;
+  sf::Vector2i _size;
+  int _cellSize{1};
+  std::vector<uint32_t> _offsets;
+  std::vector<Entry> _entries;
+};
+} // namespace ng
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <regex>
 #include "Actor.h"
 #include "Engine.h"
@@ -8,7 +9,9 @@
 #include "RoomScaling.h"
 #include "SoundDefinition.h"
 #include "SoundManager.h"
+#include "_NGUtil.h"
 #include "Text.h"
+#include "ThreadPool.h"
 
 namespace ng
 {
@@ -59,7 +62,7 @@ struct Actor::Impl
         bool _isTalking;
         std::wstring _sayText;
         Lip _lip;
-        int _index;
+        size_t _index;
         sf::Vector2i _talkOffset{0, 90};
         sf::Color _talkColor;
         sf::Clock _clock;
@@ -71,7 +74,7 @@ struct Actor::Impl
     explicit Impl(Engine &engine)
         : _engine(engine),
           _settings(engine.getSettings()),
-          _costume(engine.getTextureManager()),
+          _costume(engine.getCostumeManager(), engine.getAnimationSystem()),
           _color(sf::Color::White),
           _zorder(0),
           _use(true),
@@ -87,6 +90,7 @@ struct Actor::Impl
     std::string _name, _icon;
     sf::Color _color;
     sf::Vector2i _renderOffset;
+    sf::Vector2f _previousPosition;
     int _zorder;
     bool _use;
     Room *_pRoom;
@@ -97,9 +101,64 @@ struct Actor::Impl
     sf::Vector2i _speed;
     float _volume;
     std::shared_ptr<Path> _path;
+    // path computed by a worker thread, the actor starts walking when it's ready
+    std::future<std::vector<sf::Vector2i>> _pendingPath;
+    std::optional<Facing> _pendingFacing;
     HSQOBJECT _table;
+    struct SoundTrigger
+    {
+        std::shared_ptr<SoundDefinition> sound;
+        // set once the lookup has been retried when the sound is triggered, even if it failed
+        bool isResolved{false};
+    };
+    std::vector<SoundTrigger> _soundTriggers;
+
+    void resolveSoundTriggers();
+    std::shared_ptr<SoundDefinition> resolveSoundTrigger(size_t index);
+    void updatePendingPath();
 };
 
+void Actor::Impl::updatePendingPath()
+{
+    if (!_pendingPath.valid() || _pendingPath.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    auto path = _pendingPath.get();
+    _path = std::make_unique<Path>(path);
+
+    if (path.size() < 2)
+        return;
+
+    _walkingState.setDestination(path, _pendingFacing);
+}
+
+void Actor::Impl::resolveSoundTriggers()
+{
+    _soundTriggers.clear();
+    auto &pDefinition = _costume.getDefinition();
+    if (!pDefinition)
+        return;
+    auto size = pDefinition->getSoundTriggers().size();
+    _soundTriggers.reserve(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        auto sound = resolveSoundTrigger(i);
+        _soundTriggers.push_back({sound, sound != nullptr});
+    }
+}
+
+std::shared_ptr<SoundDefinition> Actor::Impl::resolveSoundTrigger(size_t index)
+{
+    auto &name = _costume.getDefinition()->getSoundTriggers()[index];
+    auto sound = _engine.getSoundDefinition(name);
+    if (sound)
+    {
+        // load the buffer now, the sound is played when the frame is reached
+        sound->load();
+    }
+    return sound;
+}
+
 void Actor::setName(const std::string &name)
 {
     pImpl->_name = name;
@@ -228,12 +287,13 @@ const sf::Vector2i &Actor::getWalkSpeed() const
 
 void Actor::stopWalking()
 {
+    pImpl->_pendingPath = {};
     pImpl->_walkingState.stop();
 }
 
 bool Actor::isWalking() const
 {
-    return pImpl->_walkingState.isWalking();
+    return pImpl->_walkingState.isWalking() || pImpl->_pendingPath.valid();
 }
 
 void Actor::setVolume(float volume)
@@ -401,6 +461,7 @@ void Actor::Impl::TalkingState::load(int id)
     path.append(name).append(".lip");
     std::cout << "load lip " << path << std::endl;
     _lip.setSettings(_pActor->pImpl->_engine.getSettings());
+    _lip.setTable(&_pActor->pImpl->_engine.getLipTable());
     _lip.load(path);
 
     _sayText = _pActor->pImpl->_engine.getText(id);
@@ -423,12 +484,12 @@ void Actor::Impl::TalkingState::update(const sf::Time &elapsed)
     if (!_isTalking)
         return;
 
-    auto time = _lip.getData()[_index].time;
-    if (_clock.getElapsedTime() > time)
+    const auto &data = _lip.getData();
+    if (_index < data.size() && _clock.getElapsedTime() > data[_index].time)
     {
         _index = _index + 1;
     }
-    if (_index == _lip.getData().size())
+    if (_index >= data.size())
     {
         if (_ids.empty())
         {
@@ -441,7 +502,7 @@ void Actor::Impl::TalkingState::update(const sf::Time &elapsed)
         _ids.erase(_ids.begin());
         return;
     }
-    auto letter = _lip.getData()[_index].letter;
+    auto letter = data[_index].letter;
     if (letter == 'X' || letter == 'G')
         letter = 'A';
     if (letter == 'H')
@@ -495,6 +556,8 @@ void Actor::setRoom(Room *pRoom)
     {
         pImpl->_pRoom->removeEntity(this);
     }
+    // the path of the previous room is useless
+    pImpl->_pendingPath = {};
     pImpl->_pRoom = pRoom;
     pImpl->_pRoom->setAsParallaxLayer(this, 0);
 }
@@ -509,6 +572,7 @@ void Actor::setCostume(const std::string &name, const std::string &sheet)
     std::string path;
     path.append(name).append(".json");
     pImpl->_costume.loadCostume(path, sheet);
+    pImpl->resolveSoundTriggers();
     // don't know if it's necessary, reyes has no costume in the intro
     pImpl->_costume.setFacing(Facing::FACE_FRONT);
     pImpl->_costume.setAnimation("stand_front");
@@ -521,6 +585,7 @@ void Actor::draw(sf::RenderTarget &target, sf::RenderStates states) const
     auto size = pImpl->_pRoom->getRoomSize();
     auto scale = pImpl->_pRoom->getRoomScaling().getScaling(size.y - getPosition().y);
     auto transform = _transform;
+    transform.setPosition(interpolate(pImpl->_previousPosition, getPosition(), pImpl->_engine.getRenderInterpolation()));
     transform.scale(scale, scale);
     transform.move((sf::Vector2f)-pImpl->_renderOffset * scale);
     states.transform *= transform.getTransform();
@@ -551,7 +616,8 @@ void Actor::drawForeground(sf::RenderTarget &target, sf::RenderStates states) co
 
 void Actor::update(const sf::Time &elapsed)
 {
-    pImpl->_costume.update(elapsed);
+    pImpl->_previousPosition = getPosition();
+    pImpl->updatePendingPath();
     pImpl->_walkingState.update(elapsed);
     pImpl->_talkingState.update(elapsed);
 }
@@ -561,21 +627,40 @@ void Actor::walkTo(const sf::Vector2f &destination, std::optional<Facing> facing
     if (pImpl->_pRoom == nullptr)
         return;
 
-    auto path = pImpl->_pRoom->calculatePath((sf::Vector2i)getPosition(), (sf::Vector2i)destination);
-    pImpl->_path = std::make_unique<Path>(path);
-
-    if (path.size() < 2)
+    auto pathFinder = pImpl->_pRoom->getPathFinder();
+    if (!pathFinder)
+    {
+        std::cerr << pImpl->_name << " can't walk to (" << destination.x << ',' << destination.y << "), room "
+                  << pImpl->_pRoom->getId() << " has no walkbox" << std::endl;
         return;
+    }
 
-    pImpl->_walkingState.setDestination(path, facing);
+    // the actor is walking until the path arrives, so a script waiting for the walk doesn't resume too early
+    auto from = (sf::Vector2i)getPosition();
+    auto to = (sf::Vector2i)destination;
+    pImpl->_pendingPath = pImpl->_engine.getThreadPool().submit([pathFinder, from, to]() { return pathFinder->calculatePath(from, to); });
+    pImpl->_pendingFacing = facing;
 }
 
-void Actor::trigSound(const std::string &name)
+void Actor::trigSound(int soundTrigger)
 {
-    auto soundId = pImpl->_engine.getSoundDefinition(name);
-    if (!soundId)
+    if (soundTrigger < 0 || soundTrigger >= static_cast<int>(pImpl->_soundTriggers.size()))
+        return;
+    auto &trigger = pImpl->_soundTriggers[soundTrigger];
+    if (!trigger.isResolved)
+    {
+        // the sound can be defined by a script after the costume has been loaded, it's looked up once more
+        trigger.sound = pImpl->resolveSoundTrigger(soundTrigger);
+        trigger.isResolved = true;
+        if (!trigger.sound)
+        {
+            std::cerr << "Sound trigger " << pImpl->_costume.getDefinition()->getSoundTriggers()[soundTrigger]
+                      << " of " << pImpl->_name << " not found, it won't be played" << std::endl;
+        }
+    }
+    if (!trigger.sound)
         return;
-    pImpl->_engine.getSoundManager().playSound(soundId);
+    pImpl->_engine.getSoundManager().playSound(trigger.sound);
 }
 
 void Actor::setFps(int fps)
@@ -11,6 +11,8 @@ ActorIcons::ActorIcons(std::array<ActorIconSlot, 6> &actorsIconSlots,
       _actorsIconSlots(actorsIconSlots),
       _verbUiColors(verbUiColors),
       _pCurrentActor(pCurrentActor),
+      _isInside(false),
+      _position(0),
       _isMouseButtonPressed(false)
 {
 }
@@ -21,6 +23,7 @@ void ActorIcons::setEngine(Engine *pEngine)
     _gameSheet.setTextureManager(&_pEngine->getTextureManager());
     _gameSheet.setSettings(&_pEngine->getSettings());
     _gameSheet.load("GameSheet");
+    _batch.setTexture(&_gameSheet.getTexture());
 }
 
 void ActorIcons::setMousePosition(const sf::Vector2f &pos)
@@ -30,7 +33,7 @@ void ActorIcons::setMousePosition(const sf::Vector2f &pos)
 
 void ActorIcons::update(const sf::Time &elapsed)
 {
-    auto screen = _pEngine->getWindow().getView().getSize();
+    auto screen = _pEngine->getView().getSize();
     sf::FloatRect iconRect(screen.x - 16, 0, 16, 16 + (_isInside ? getIconsNum() * 15 : 0));
     bool wasInside = _isInside;
     _isInside = iconRect.contains(_mousePos);
@@ -92,56 +95,85 @@ int ActorIcons::getIconsNum() const
     return numIcons;
 }
 
+bool ActorIcons::State::operator==(const State &other) const
+{
+    return pCurrentActor == other.pCurrentActor && isInside == other.isInside && position == other.position &&
+           screen == other.screen && actors == other.actors && icons == other.icons &&
+           backColors == other.backColors && frameColors == other.frameColors;
+}
+
 void ActorIcons::draw(sf::RenderTarget &target, sf::RenderStates states) const
 {
     if (!_pCurrentActor)
         return;
 
-    int numIcons = 0;
-    auto screen = target.getView().getSize();
-    sf::Vector2f offset(screen.x - 8, 8);
+    State state;
+    state.pCurrentActor = _pCurrentActor;
+    state.isInside = _isInside;
+    state.position = _position;
+    state.screen = target.getView().getSize();
+    for (auto i = 0; i < _actorsIconSlots.size(); i++)
+    {
+        const auto &selectableActor = _actorsIconSlots.at(i);
+        if (!selectableActor.pActor || (!selectableActor.selectable && selectableActor.pActor != _pCurrentActor))
+            continue;
+        state.actors.at(i) = selectableActor.pActor;
+        state.icons.at(i) = selectableActor.pActor->getIcon();
+        state.backColors.at(i) = _verbUiColors.at(i).inventoryBackground;
+        state.frameColors.at(i) = _verbUiColors.at(i).inventoryFrame;
+    }
 
-    if (_pCurrentActor)
+    // the icons only move while the panel is opening or closing
+    if (!_state || !(*_state == state))
     {
-        sf::Uint8 alpha = _isInside ? 0xFF : 0x60;
+        updateBatch(state);
+        _state = state;
+    }
+    target.draw(_batch, states);
+}
 
-        auto i = getCurrentActorIndex();
-        const auto &icon = _actorsIconSlots.at(i).pActor->getIcon();
+void ActorIcons::updateBatch(const State &state) const
+{
+    _batch.clear();
 
-        offset.y = getOffsetY(numIcons);
-        drawActorIcon(target, icon, i, offset, alpha);
-        numIcons++;
-    }
+    int numIcons = 0;
+    auto screen = state.screen;
+    sf::Vector2f offset(screen.x - 8, 8);
 
-    if (!_isInside)
+    sf::Uint8 alpha = state.isInside ? 0xFF : 0x60;
+
+    auto i = getCurrentActorIndex();
+    if (i == -1)
+        return;
+    offset.y = getOffsetY(numIcons);
+    addActorIcon(state.icons.at(i), i, offset, alpha);
+    numIcons++;
+
+    if (!state.isInside)
         return;
 
     for (auto i = 0; i < _actorsIconSlots.size(); i++)
     {
-        const auto &selectableActor = _actorsIconSlots.at(i);
-        if (!selectableActor.selectable || !selectableActor.pActor || selectableActor.pActor == _pCurrentActor)
+        if (!state.actors.at(i) || state.actors.at(i) == state.pCurrentActor)
             continue;
 
         offset.y = getOffsetY(numIcons);
-        const auto &icon = selectableActor.pActor->getIcon();
-        drawActorIcon(target, icon, i, offset, 0xFF);
+        addActorIcon(state.icons.at(i), i, offset, 0xFF);
         numIcons++;
     }
 
     offset.y = getOffsetY(numIcons);
-    drawActorIcon(target, "icon_gear", sf::Color::Black, sf::Color(128, 128, 128), offset, 0xFF);
+    addActorIcon("icon_gear", sf::Color::Black, sf::Color(128, 128, 128), offset, 0xFF);
 }
 
-void ActorIcons::drawActorIcon(sf::RenderTarget &target, const std::string &icon, int actorSlot, const sf::Vector2f &offset, sf::Uint8 alpha) const
+void ActorIcons::addActorIcon(const std::string &icon, int actorSlot, const sf::Vector2f &offset, sf::Uint8 alpha) const
 {
     const auto &colors = _verbUiColors[actorSlot];
-    drawActorIcon(target, icon, colors.inventoryBackground, colors.inventoryFrame, offset, alpha);
+    addActorIcon(icon, colors.inventoryBackground, colors.inventoryFrame, offset, alpha);
 }
 
-void ActorIcons::drawActorIcon(sf::RenderTarget &target, const std::string &icon, sf::Color backColor, sf::Color frameColor, const sf::Vector2f &offset, sf::Uint8 alpha) const
+void ActorIcons::addActorIcon(const std::string &icon, sf::Color backColor, sf::Color frameColor, const sf::Vector2f &offset, sf::Uint8 alpha) const
 {
-    sf::RenderStates states;
-    const auto &texture = _gameSheet.getTexture();
     auto backRect = _gameSheet.getRect("icon_background");
     auto backSpriteSourceSize = _gameSheet.getSpriteSourceSize("icon_background");
     auto backSourceSize = _gameSheet.getSourceSize("icon_background");
@@ -159,8 +191,7 @@ void ActorIcons::drawActorIcon(sf::RenderTarget &target, const std::string &icon
     s.setPosition(offset);
     s.setOrigin(-pos);
     s.setTextureRect(backRect);
-    s.setTexture(texture);
-    target.draw(s, states);
+    _batch.add(s);
 
     auto rect = _gameSheet.getRect(icon);
     auto spriteSourceSize = _gameSheet.getSpriteSourceSize(icon);
@@ -171,7 +202,7 @@ void ActorIcons::drawActorIcon(sf::RenderTarget &target, const std::string &icon
     c.a = alpha;
     s.setColor(c);
     s.setTextureRect(rect);
-    target.draw(s, states);
+    _batch.add(s);
 
     pos = sf::Vector2f(-frameSourceSize.x / 2.f + frameSpriteSourceSize.left, -frameSourceSize.y / 2.f + frameSpriteSourceSize.top);
     s.setOrigin(-pos);
@@ -179,7 +210,7 @@ void ActorIcons::drawActorIcon(sf::RenderTarget &target, const std::string &icon
     c.a = alpha;
     s.setColor(c);
     s.setTextureRect(frameRect);
-    target.draw(s, states);
+    _batch.add(s);
 }
 
 int ActorIcons::getCurrentActorIndex() const
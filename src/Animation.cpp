@@ -3,63 +3,64 @@
 #include <iostream>
 #include "Animation.h"
 #include "Object.h"
+#include "Room.h"
+#include "RenderStats.h"
 
 namespace ng
 {
-Animation::Animation(const sf::Texture &texture, std::string name)
-    : _sprite(texture), _name(std::move(name)), _fps(10), _index(0), _state(AnimState::Pause)
+Animation::Animation(AnimationSystem &animationSystem, const sf::Texture &texture, std::string name)
+    : _animationSystem(animationSystem), _track(animationSystem.add(this)), _sprite(texture), _name(std::move(name))
 {
+    // object animations always restart from the first frame when they reach the end
+    _animationSystem.setFps(_track, 10);
+    _animationSystem.setLoop(_track, true);
 }
 
-Animation::~Animation() = default;
+Animation::~Animation()
+{
+    _animationSystem.remove(_track);
+}
 
 void Animation::reset()
 {
+    _animationSystem.setFrameCount(_track, static_cast<int>(_rects.size()));
     if (_rects.empty())
         return;
-    _index = _rects.size() - 1;
-    auto &sourceRect = _sourceRects.at(_index);
-    auto size = _sizes.at(_index);
-    _sprite.setTextureRect(_rects.at(_index));
-    _sprite.setOrigin(sf::Vector2f(size.x/ 2.f - sourceRect.left, size.y / 2.f - sourceRect.top));
+    auto index = static_cast<int>(_rects.size()) - 1;
+    _animationSystem.rewind(_track, index);
+    updateFrame(index);
 }
 
-void Animation::play(bool loop)
+void Animation::play(bool)
 {
-    _loop = loop;
-    _state = AnimState::Play;
+    _animationSystem.play(_track);
     reset();
 }
 
-void Animation::update(const sf::Time &elapsed)
+void Animation::onAnimationEvent(const AnimationEvent &event)
 {
-    if (_state == AnimState::Pause)
-        return;
-
-    if (_rects.empty())
-        return;
-
-    _time += elapsed;
-    if (_time.asSeconds() > (1.f / _fps))
+    updateFrame(event.index);
+    if (_pObject && _pObject->getRoom())
     {
-        _time = sf::seconds(0);
-        _index = (_index + 1) % _rects.size();
-
-        auto sourceRect = _sourceRects.at(_index);
-        auto size = _sizes.at(_index);
-        _sprite.setTextureRect(_rects.at(_index));
-        _sprite.setOrigin(sf::Vector2f(size.x / 2.f - sourceRect.left, size.y / 2.f - sourceRect.top));
-
-        updateTrigger();
+        _pObject->getRoom()->setDirty(true);
     }
+    updateTrigger(event.index);
+}
+
+void Animation::updateFrame(int index)
+{
+    auto &sourceRect = _sourceRects.at(index);
+    auto size = _sizes.at(index);
+    _sprite.setTextureRect(_rects.at(index));
+    _sprite.setOrigin(sf::Vector2f(size.x / 2.f - sourceRect.left, size.y / 2.f - sourceRect.top));
 }
 
-void Animation::updateTrigger()
+void Animation::updateTrigger(int index)
 {
     if (_triggers.empty())
         return;
 
-    auto trigger = _triggers.at(_index);
+    auto trigger = _triggers.at(index);
     if (trigger.has_value() && _pObject)
     {
         _pObject->trig(*trigger);
@@ -71,5 +72,6 @@ void Animation::draw(sf::RenderTarget &target, sf::RenderStates states) const
     if (_rects.empty())
         return;
     target.draw(_sprite, states);
+    RenderStats::get().addDrawCall(_sprite.getTexture(), 4);
 }
 } // namespace ng
@@ -0,0 +1,154 @@
+#include "AnimationSystem.h"
+
+namespace ng
+{
+AnimationSystem::AnimationSystem() = default;
+
+AnimationSystem::~AnimationSystem() = default;
+
+AnimationTrack AnimationSystem::add(AnimationListener *pListener)
+{
+    AnimationTrack track;
+    if (!_freeTracks.empty())
+    {
+        track = _freeTracks.back();
+        _freeTracks.pop_back();
+    }
+    else
+    {
+        track = _times.size();
+        _times.push_back(0);
+        _frameTimes.push_back(0);
+        _rates.push_back(0);
+        _indices.push_back(0);
+        _frameCounts.push_back(0);
+        _fps.push_back(0);
+        _flags.push_back(0);
+        _listeners.push_back(nullptr);
+    }
+    _times[track] = 0;
+    _frameTimes[track] = 0;
+    _rates[track] = 0;
+    _indices[track] = 0;
+    _frameCounts[track] = 0;
+    _fps[track] = 0;
+    _flags[track] = 0;
+    _listeners[track] = pListener;
+    return track;
+}
+
+void AnimationSystem::remove(AnimationTrack track)
+{
+    _rates[track] = 0;
+    _flags[track] = 0;
+    _listeners[track] = nullptr;
+    // the track is reused after the next update, so the pending events can't be routed to a new listener
+    _removedTracks.push_back(track);
+}
+
+void AnimationSystem::setFrameCount(AnimationTrack track, int count)
+{
+    _frameCounts[track] = count;
+    updateRate(track);
+}
+
+void AnimationSystem::setFps(AnimationTrack track, int fps)
+{
+    _fps[track] = fps;
+    _frameTimes[track] = fps > 0 ? 1.f / fps : 0.f;
+    updateRate(track);
+}
+
+void AnimationSystem::setLoop(AnimationTrack track, bool loop)
+{
+    if (loop)
+        _flags[track] |= Loop;
+    else
+        _flags[track] &= ~Loop;
+}
+
+void AnimationSystem::play(AnimationTrack track)
+{
+    _flags[track] |= Playing;
+    updateRate(track);
+}
+
+void AnimationSystem::pause(AnimationTrack track)
+{
+    _flags[track] &= ~Playing;
+    updateRate(track);
+}
+
+void AnimationSystem::rewind(AnimationTrack track, int index)
+{
+    _indices[track] = index;
+    _times[track] = 0;
+}
+
+void AnimationSystem::updateRate(AnimationTrack track)
+{
+    auto isAdvancing = (_flags[track] & Playing) && _fps[track] > 0 && _frameCounts[track] > 0;
+    _rates[track] = isAdvancing ? 1.f : 0.f;
+}
+
+void AnimationSystem::update(const sf::Time &elapsed)
+{
+    _freeTracks.insert(_freeTracks.end(), _removedTracks.begin(), _removedTracks.end());
+    _removedTracks.clear();
+    _events.clear();
+
+    // accumulate the time of the playing tracks, this loop has no branch so it can be vectorized
+    auto seconds = elapsed.asSeconds();
+    auto count = _times.size();
+    auto *pTimes = _times.data();
+    const auto *pRates = _rates.data();
+    for (size_t i = 0; i < count; i++)
+    {
+        pTimes[i] += seconds * pRates[i];
+    }
+
+    const auto *pFrameTimes = _frameTimes.data();
+    for (size_t i = 0; i < count; i++)
+    {
+        if (pRates[i] == 0.f || pTimes[i] <= pFrameTimes[i])
+            continue;
+        advance(i);
+    }
+
+    // notify the listeners once every track is up to date, they can add or remove tracks
+    for (size_t i = 0; i < _events.size(); i++)
+    {
+        auto event = _events[i];
+        auto pListener = _listeners[event.track];
+        if (!pListener)
+            continue;
+        pListener->onAnimationEvent(event);
+    }
+}
+
+void AnimationSystem::advance(AnimationTrack track)
+{
+    // keep the remaining time so the animation speed doesn't depend on the update rate
+    auto frameTime = _frameTimes[track];
+    auto frameCount = _frameCounts[track];
+    auto index = _indices[track];
+    while (_times[track] > frameTime)
+    {
+        _times[track] -= frameTime;
+        index++;
+        if (index == frameCount)
+        {
+            if (!(_flags[track] & Loop))
+            {
+                _indices[track] = frameCount - 1;
+                pause(track);
+                _events.push_back({track, frameCount - 1, true});
+                return;
+            }
+            index = 0;
+        }
+        _events.push_back({track, index, false});
+    }
+    _indices[track] = index;
+}
+} // namespace ng
@@ -1,14 +1,13 @@
 #include <fstream>
 #include <iostream>
-#include <nlohmann/json.hpp>
 #include "Costume.h"
 #include "_NGUtil.h"
 
 namespace ng
 {
-Costume::Costume(TextureManager &textureManager)
-    : _settings(textureManager.getSettings()),
-      _textureManager(textureManager),
+Costume::Costume(CostumeManager &costumeManager, AnimationSystem &animationSystem)
+    : _costumeManager(costumeManager),
+      _animationSystem(animationSystem),
       _pCurrentAnimation(nullptr),
       _facing(Facing::FACE_FRONT),
       _animation("stand"),
@@ -38,12 +37,12 @@ void Costume::setLayerVisible(const std::string &name, bool isVisible)
     }
     if (_pCurrentAnimation == nullptr)
         return;
-    auto it = std::find_if(_pCurrentAnimation->getLayers().begin(), _pCurrentAnimation->getLayers().end(), [name](CostumeLayer *pLayer) {
-        return pLayer->getName() == name;
+    auto it = std::find_if(_pCurrentAnimation->getLayers().begin(), _pCurrentAnimation->getLayers().end(), [&name](const CostumeLayer &layer) {
+        return layer.getName() == name;
     });
     if (it != _pCurrentAnimation->getLayers().end())
     {
-        (*it)->setVisible(isVisible);
+        it->setVisible(isVisible);
     }
 }
 
@@ -72,8 +71,9 @@ void Costume::setState(const std::string &name)
 
 void Costume::loadCostume(const std::string &path, const std::string &sheet)
 {
-    _path = path;
-    _sheet = sheet;
+    _pDefinition = _costumeManager.get(path, sheet);
+    _animations.clear();
+    _pCurrentAnimation = nullptr;
 }
 
 bool Costume::setAnimation(const std::string &animName)
@@ -81,100 +81,37 @@ bool Costume::setAnimation(const std::string &animName)
     if (_pCurrentAnimation && _pCurrentAnimation->getName() == animName)
         return true;
 
-    GGPackValue hash;
-    _settings.readEntry(_path, hash);
-    if (_sheet.empty())
-    {
-        _sheet = hash["sheet"].string_value;
-    }
-
-    std::string sheetPath;
-    sheetPath.append(_sheet).append(".json");
-    std::vector<char> buffer;
-    _settings.readEntry(sheetPath, buffer);
-    auto jSheet = nlohmann::json::parse(buffer.data());
+    if (!_pDefinition)
+        return false;
 
-    // load texture
-    _texture = _textureManager.get(_sheet);
+    auto pAnimation = _pDefinition->getAnimation(animName);
+    if (!pAnimation)
+        return false;
 
-    // find animation matching name
-    for (auto j : hash["animations"].array_value)
+    // only the current animation is playing
+    if (_pCurrentAnimation)
     {
-        auto name = j["name"].string_value;
-        // std::cout << "Anim: " << name << std::endl;
-        if (animName != name)
-            continue;
+        _pCurrentAnimation->pause();
+    }
 
-        _pCurrentAnimation = std::make_unique<CostumeAnimation>(name);
-        for (auto jLayer : j["layers"].array_value)
-        {
-            auto layer = new CostumeLayer();
-            layer->setTexture(&_texture);
-            auto fps = jLayer["fps"].isNull() ? 10 : jLayer["fps"].int_value;
-            layer->setFps(fps);
-            auto layerName = jLayer["name"].string_value;
-            layer->setVisible(_hiddenLayers.find(layerName) == _hiddenLayers.end());
-            layer->setName(layerName);
-            if (!jLayer["flags"].isNull())
-            {
-                layer->setFlags(jLayer["flags"].int_value);
-            }
-            for (const auto &jFrame : jLayer["frames"].array_value)
-            {
-                auto frameName = jFrame.string_value;
-                if (frameName == "null")
-                {
-                    layer->getFrames().emplace_back();
-                    layer->getSourceFrames().emplace_back();
-                    layer->getSizes().emplace_back();
-                }
-                else
-                {
-                    auto jFrames = jSheet["frames"];
-                    auto jf = jFrames[frameName.c_str()];
-                    layer->getFrames().push_back(_toRect(jf["frame"]));
-                    layer->getSourceFrames().push_back(_toRect(jf["spriteSourceSize"]));
-                    layer->getSizes().push_back(_toSize(jf["sourceSize"]));
-                }
-            }
-            if (!jLayer["triggers"].isNull())
-            {
-                for (const auto &jTrigger : jLayer["triggers"].array_value)
-                {
-                    if (!jTrigger.isNull())
-                    {
-                        auto triggerName = jTrigger.string_value;
-                        char *end;
-                        auto trigger = std::strtol(triggerName.data() + 1, &end, 10);
-                        if (end == triggerName.data() + 1)
-                        {
-                            layer->getSoundTriggers().emplace_back(triggerName.data() + 1);
-                            layer->getTriggers().emplace_back(std::nullopt);
-                        }
-                        else
-                        {
-                            layer->getTriggers().emplace_back(trigger);
-                            layer->getSoundTriggers().emplace_back(std::nullopt);
-                        }
-                    }
-                    else
-                    {
-                        layer->getSoundTriggers().emplace_back(std::nullopt);
-                        layer->getTriggers().emplace_back(std::nullopt);
-                    }
-                }
-            }
-            for (const auto &jOffset : jLayer["offsets"].array_value)
-            {
-                layer->getOffsets().emplace_back((sf::Vector2i)_parsePos(jOffset.string_value));
-            }
-            layer->setActor(_pActor);
-            _pCurrentAnimation->getLayers().push_back(layer);
-        }
-        std::cout << "found animation: " << name << std::endl;
-        return true;
+    auto &animation = _animations[pAnimation];
+    if (!animation)
+    {
+        animation = std::make_unique<CostumeAnimation>(*pAnimation, _animationSystem);
     }
-    return false;
+    else
+    {
+        animation->reset();
+    }
+    for (auto &layer : animation->getLayers())
+    {
+        layer.setTexture(&_pDefinition->getTexture());
+        layer.setVisible(_hiddenLayers.find(layer.getName()) == _hiddenLayers.end());
+        layer.setActor(_pActor);
+    }
+    _pCurrentAnimation = animation.get();
+    std::cout << "found animation: " << animName << std::endl;
+    return true;
 }
 
 static bool _startsWith(const std::string &str, const std::string &prefix)
@@ -188,11 +125,11 @@ void Costume::updateAnimation()
     if (_pCurrentAnimation && _startsWith(_animation, "eyes_"))
     {
         auto &layers = _pCurrentAnimation->getLayers();
-        for (auto layer : layers)
+        for (auto &layer : layers)
         {
-            if (!_startsWith(layer->getName(), "eyes_"))
+            if (!_startsWith(layer.getName(), "eyes_"))
                 continue;
-            setLayerVisible(layer->getName(), false);
+            setLayerVisible(layer.getName(), false);
         }
         setLayerVisible(_animation, true);
         return;
@@ -223,20 +160,13 @@ void Costume::updateAnimation()
     if (_pCurrentAnimation)
     {
         auto &layers = _pCurrentAnimation->getLayers();
-        for (auto layer : layers)
+        for (auto &layer : layers)
         {
-            layer->setLeftDirection(_facing == Facing::FACE_LEFT);
+            layer.setLeftDirection(_facing == Facing::FACE_LEFT);
         }
     }
 }
 
-void Costume::update(const sf::Time &elapsed)
-{
-    if (!_pCurrentAnimation)
-        return;
-    _pCurrentAnimation->update(elapsed);
-}
-
 void Costume::draw(sf::RenderTarget &target, sf::RenderStates states) const
 {
     if (!_pCurrentAnimation)
@@ -253,12 +183,12 @@ void Costume::setHeadIndex(int index)
         s << _headAnimName << (i + 1);
         // std::cout << "setLayerVisible(" << s.str() << "," << (_headIndex == i) << ")" << std::endl;
         auto layerName = s.str();
-        auto it = std::find_if(_pCurrentAnimation->getLayers().begin(), _pCurrentAnimation->getLayers().end(), [layerName](CostumeLayer *pLayer) {
-            return pLayer->getName() == layerName;
+        auto it = std::find_if(_pCurrentAnimation->getLayers().begin(), _pCurrentAnimation->getLayers().end(), [&layerName](const CostumeLayer &layer) {
+            return layer.getName() == layerName;
         });
         if (it != _pCurrentAnimation->getLayers().end())
         {
-            (*it)->setVisible(_headIndex == i);
+            it->setVisible(_headIndex == i);
         }
     }
 }
@@ -1,38 +1,80 @@
+#include <algorithm>
 #include <utility>
 
 #include "CostumeAnimation.h"
 
 namespace ng
 {
-CostumeAnimation::CostumeAnimation(std::string name)
-    : _name(std::move(name)), _state(AnimationState::Pause), _loop(false)
+CostumeAnimation::CostumeAnimation(const CostumeAnimationDefinition &definition, AnimationSystem &animationSystem)
+    : _pDefinition(&definition), _animationSystem(animationSystem), _state(AnimationState::Pause), _loop(false)
 {
+    _layers.reserve(definition.layers.size());
+    for (const auto &layer : definition.layers)
+    {
+        _layers.emplace_back(layer, _animationSystem, _animationSystem.add(this));
+    }
 }
 
-CostumeAnimation::~CostumeAnimation() = default;
+CostumeAnimation::~CostumeAnimation()
+{
+    for (auto &layer : _layers)
+    {
+        _animationSystem.remove(layer.getTrack());
+    }
+}
+
+void CostumeAnimation::reset()
+{
+    _state = AnimationState::Pause;
+    _loop = false;
+    for (auto &layer : _layers)
+    {
+        layer.reset();
+    }
+}
 
 void CostumeAnimation::play(bool loop)
 {
     _loop = loop;
     for (auto &layer : _layers)
     {
-        layer->setLoop(loop);
+        layer.setLoop(loop);
+        layer.play();
     }
-    _state = AnimationState::Play;
+    // an animation without layer has nothing to wait for
+    _state = _layers.empty() && !loop ? AnimationState::Pause : AnimationState::Play;
 }
 
-void CostumeAnimation::update(const sf::Time &elapsed)
+void CostumeAnimation::pause()
 {
-    if (!isPlaying())
-        return;
-    bool isFinished = !_loop;
+    _state = AnimationState::Pause;
     for (auto &layer : _layers)
     {
-        isFinished &= layer->update(elapsed);
+        layer.pause();
     }
-    if (isFinished)
+}
+
+void CostumeAnimation::onAnimationEvent(const AnimationEvent &event)
+{
+    auto it = std::find_if(_layers.begin(), _layers.end(), [&event](const CostumeLayer &layer) {
+        return layer.getTrack() == event.track;
+    });
+    if (it == _layers.end())
+        return;
+
+    if (!event.finished)
+    {
+        it->onFrameChanged(event.index);
+        return;
+    }
+
+    // the animation is finished when all its layers reached their last frame
+    auto isPlaying = std::any_of(_layers.begin(), _layers.end(), [](const CostumeLayer &layer) {
+        return layer.isPlaying();
+    });
+    if (!isPlaying)
     {
-        pause();
+        _state = AnimationState::Pause;
     }
 }
 
@@ -40,7 +82,7 @@ void CostumeAnimation::draw(sf::RenderTarget &target, sf::RenderStates states) c
 {
     for (auto &layer : _layers)
     {
-        target.draw(*layer, states);
+        target.draw(layer, states);
     }
 }
 
@@ -48,7 +90,7 @@ void CostumeAnimation::setFps(int fps)
 {
     for (auto &layer : _layers)
     {
-        layer->setFps(fps);
+        layer.setFps(fps);
     }
 }
 
@@ -56,7 +98,7 @@ bool CostumeAnimation::contains(const sf::Vector2f& pos) const
 {
     for (auto &layer : _layers)
     {
-        if(layer->contains(pos))
+        if(layer.contains(pos))
             return true;
     }
     return false;
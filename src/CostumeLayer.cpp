@@ -1,64 +1,62 @@
 #include "CostumeLayer.h"
 #include "Actor.h"
 #include "Room.h"
+#include "RenderStats.h"
 #include "SFML/Graphics.hpp"
 
 namespace ng
 {
-CostumeLayer::CostumeLayer()
-    : _pTexture(nullptr),
-      _fps(10),
-      _flags(0),
-      _index(0),
+CostumeLayer::CostumeLayer(const CostumeLayerDefinition &definition, AnimationSystem &animationSystem, AnimationTrack track)
+    : _pDefinition(&definition),
+      _pAnimationSystem(&animationSystem),
+      _track(track),
+      _pTexture(nullptr),
       _isVisible(true),
       _pActor(nullptr),
-      _loop(false),
       _leftDirection(false)
 {
+    _pAnimationSystem->setFrameCount(_track, static_cast<int>(definition.frames.size()));
+    reset();
 }
 
 CostumeLayer::~CostumeLayer() = default;
 
-bool CostumeLayer::update(const sf::Time &elapsed)
+void CostumeLayer::reset()
 {
-    _time += elapsed;
-    if (_time.asSeconds() > (1.f / _fps))
+    _pAnimationSystem->pause(_track);
+    _pAnimationSystem->setFps(_track, _pDefinition->fps);
+    _pAnimationSystem->setLoop(_track, false);
+    _pAnimationSystem->rewind(_track, 0);
+}
+
+void CostumeLayer::onFrameChanged(int index)
+{
+    if (_pActor && _pActor->getRoom())
     {
-        _time = sf::seconds(0);
-        _index = _index + 1;
-        if (_index == _frames.size())
-        {
-            if (!_loop)
-            {
-                _index--;
-                return true;
-            }
-            _index = 0;
-        }
-        updateTrigger();
-        updateSoundTrigger();
+        _pActor->getRoom()->setDirty(true);
     }
-    return false;
+    updateTrigger(index);
+    updateSoundTrigger(index);
 }
 
-void CostumeLayer::updateTrigger()
+void CostumeLayer::updateTrigger(int index)
 {
-    if (_triggers.empty())
+    if (_pDefinition->triggers.empty())
         return;
 
-    auto trigger = _triggers[_index];
+    auto trigger = _pDefinition->triggers[index];
     if (trigger.has_value() && _pActor)
     {
         _pActor->trig(*trigger);
     }
 }
 
-void CostumeLayer::updateSoundTrigger()
+void CostumeLayer::updateSoundTrigger(int index)
 {
-    if (_soundTriggers.empty())
+    if (_pDefinition->soundTriggers.empty())
         return;
 
-    auto trigger = _soundTriggers[_index];
+    auto trigger = _pDefinition->soundTriggers[index];
     if (trigger.has_value() && _pActor)
     {
         _pActor->trigSound(*trigger);
@@ -71,15 +69,15 @@ void CostumeLayer::draw(sf::RenderTarget &target, sf::RenderStates states) const
         return;
 
     auto frame = getIndex();
-    if (_frames.empty())
+    if (_pDefinition->frames.empty())
         return;
-    auto rect = _frames[frame];
-    auto sourceRect = (sf::FloatRect)_sourceFrames[frame];
-    auto size = (sf::Vector2f)_sizes[frame];
+    auto rect = _pDefinition->frames[frame];
+    auto sourceRect = (sf::FloatRect)_pDefinition->sourceFrames[frame];
+    auto size = (sf::Vector2f)_pDefinition->sizes[frame];
     sf::Vector2i offset;
-    if (!_offsets.empty())
+    if (!_pDefinition->offsets.empty())
     {
-        offset = _offsets[frame];
+        offset = _pDefinition->offsets[frame];
     }
     float x;
     if (_leftDirection)
@@ -97,17 +95,18 @@ void CostumeLayer::draw(sf::RenderTarget &target, sf::RenderStates states) const
     sprite.setOrigin(-sf::Vector2f(x, y) + (sf::Vector2f)offset);
     sprite.setColor(_pActor->getRoom()->getAmbientLight());
     target.draw(sprite, states);
+    RenderStats::get().addDrawCall(_pTexture, 4);
 }
 
 bool CostumeLayer::contains(const sf::Vector2f &pos) const
 {
     auto frame = getIndex();
-    if (_frames.empty())
+    if (_pDefinition->frames.empty())
         return false;
 
-    auto rect = (sf::FloatRect)_frames[frame];
-    auto sourceRect = (sf::FloatRect)_sourceFrames[frame];
-    auto size = (sf::Vector2f)_sizes[frame];
+    auto rect = (sf::FloatRect)_pDefinition->frames[frame];
+    auto sourceRect = (sf::FloatRect)_pDefinition->sourceFrames[frame];
+    auto size = (sf::Vector2f)_pDefinition->sizes[frame];
 
     float x;
     if (_leftDirection)
@@ -123,9 +122,9 @@ bool CostumeLayer::contains(const sf::Vector2f &pos) const
     auto y = sourceRect.top - size.y / 2.f;
 
     sf::Vector2i offset;
-    if (!_offsets.empty())
+    if (!_pDefinition->offsets.empty())
     {
-        offset = _offsets[frame];
+        offset = _pDefinition->offsets[frame];
     }
 
     sf::Transformable t;
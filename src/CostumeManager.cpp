@@ -0,0 +1,110 @@
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include "CostumeManager.h"
+#include "_NGUtil.h"
+
+namespace ng
+{
+CostumeManager::CostumeManager(TextureManager &textureManager)
+    : _textureManager(textureManager)
+{
+}
+
+CostumeManager::~CostumeManager() = default;
+
+std::shared_ptr<const CostumeDefinition> CostumeManager::get(const std::string &path, const std::string &sheet)
+{
+    auto key = path + '|' + sheet;
+    auto found = _definitions.find(key);
+    if (found == _definitions.end())
+    {
+        found = _definitions.insert(std::make_pair(key, load(path, sheet))).first;
+    }
+    return found->second;
+}
+
+std::shared_ptr<const CostumeDefinition> CostumeManager::load(const std::string &path, const std::string &sheet)
+{
+    std::cout << "Load costume " << path << std::endl;
+    auto &settings = _textureManager.getSettings();
+    GGPackValue hash;
+    settings.readEntry(path, hash);
+
+    auto sheetName = sheet.empty() ? hash["sheet"].string_value : sheet;
+    std::string sheetPath;
+    sheetPath.append(sheetName).append(".json");
+    std::vector<char> buffer;
+    settings.readEntry(sheetPath, buffer);
+    buffer.push_back('\0');
+    auto jSheet = nlohmann::json::parse(buffer.data());
+    auto &jFrames = jSheet["frames"];
+
+    auto definition = std::make_shared<CostumeDefinition>(sheetName, _textureManager.get(sheetName));
+    for (auto &j : hash["animations"].array_value)
+    {
+        CostumeAnimationDefinition animation;
+        animation.name = j["name"].string_value;
+        for (auto &jLayer : j["layers"].array_value)
+        {
+            CostumeLayerDefinition layer;
+            layer.fps = jLayer["fps"].isNull() ? 10 : jLayer["fps"].int_value;
+            layer.name = jLayer["name"].string_value;
+            if (!jLayer["flags"].isNull())
+            {
+                layer.flags = jLayer["flags"].int_value;
+            }
+            for (const auto &jFrame : jLayer["frames"].array_value)
+            {
+                auto frameName = jFrame.string_value;
+                if (frameName == "null")
+                {
+                    layer.frames.emplace_back();
+                    layer.sourceFrames.emplace_back();
+                    layer.sizes.emplace_back();
+                }
+                else
+                {
+                    auto &jf = jFrames[frameName];
+                    layer.frames.push_back(_toRect(jf["frame"]));
+                    layer.sourceFrames.push_back(_toRect(jf["spriteSourceSize"]));
+                    layer.sizes.push_back(_toSize(jf["sourceSize"]));
+                }
+            }
+            if (!jLayer["triggers"].isNull())
+            {
+                for (const auto &jTrigger : jLayer["triggers"].array_value)
+                {
+                    if (!jTrigger.isNull())
+                    {
+                        auto triggerName = jTrigger.string_value;
+                        char *end;
+                        auto trigger = std::strtol(triggerName.data() + 1, &end, 10);
+                        if (end == triggerName.data() + 1)
+                        {
+                            layer.soundTriggers.emplace_back(definition->addSoundTrigger(triggerName.data() + 1));
+                            layer.triggers.emplace_back(std::nullopt);
+                        }
+                        else
+                        {
+                            layer.triggers.emplace_back(trigger);
+                            layer.soundTriggers.emplace_back(std::nullopt);
+                        }
+                    }
+                    else
+                    {
+                        layer.soundTriggers.emplace_back(std::nullopt);
+                        layer.triggers.emplace_back(std::nullopt);
+                    }
+                }
+            }
+            for (const auto &jOffset : jLayer["offsets"].array_value)
+            {
+                layer.offsets.emplace_back((sf::Vector2i)_parsePos(jOffset.string_value));
+            }
+            animation.layers.push_back(std::move(layer));
+        }
+        definition->addAnimation(std::move(animation));
+    }
+    return definition;
+}
+} // namespace ng
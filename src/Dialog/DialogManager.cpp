@@ -97,7 +97,7 @@ void DialogManager::draw(sf::RenderTarget &target, sf::RenderStates states) cons
 
 void DialogManager::update(const sf::Time &elapsed)
 {
-    auto screen = _pEngine->getWindow().getView().getSize();
+    auto screen = _pEngine->getView().getSize();
     _isActive = !_functions.empty();
     _isActive |= std::any_of(_dialog.begin(),_dialog.end(),[](auto& line){ return line.id != 0; });
 
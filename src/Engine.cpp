@@ -8,20 +8,28 @@
 #include <math.h>
 #include "ActorIcons.h"
 #include "ActorIconSlot.h"
+#include "AnimationSystem.h"
+#include "CostumeManager.h"
+#include "Lip.h"
 #include "Cutscene.h"
 #include "Dialog/DialogManager.h"
 #include "Engine.h"
 #include "Font.h"
 #include "Inventory.h"
 #include "InventoryObject.h"
+#include "PathFinder.h"
 #include "Preferences.h"
+#include "RenderStats.h"
 #include "Room.h"
 #include "RoomScaling.h"
+#include "Screen.h"
 #include "ScriptExecute.h"
 #include "SoundManager.h"
+#include "SpriteBatch.h"
 #include "SpriteSheet.h"
 #include "Text.h"
 #include "TextDatabase.h"
+#include "ThreadPool.h"
 #include "Verb.h"
 #include "VerbExecute.h"
 #include "_NGUtil.h"
@@ -45,9 +53,28 @@ bool operator&(CursorDirection lhs, CursorDirection rhs)
 
 struct Engine::Impl
 {
+    struct VerbsState
+    {
+        int actorIndex{-1};
+        int verbId{-1};
+        sf::Vector2f screen;
+        std::array<int, 9> verbIds{};
+        sf::Color normalTint;
+        sf::Color highlight;
+
+        bool operator==(const VerbsState &other) const
+        {
+            return actorIndex == other.actorIndex && verbId == other.verbId && screen == other.screen &&
+                   verbIds == other.verbIds && normalTint == other.normalTint && highlight == other.highlight;
+        }
+    };
+
     Engine *_pEngine;
     EngineSettings &_settings;
     TextureManager _textureManager;
+    CostumeManager _costumeManager;
+    AnimationSystem _animationSystem;
+    LipTable _lipTable;
     Room *_pRoom;
     std::vector<std::unique_ptr<Actor>> _actors;
     std::vector<std::unique_ptr<Room>> _rooms;
@@ -56,6 +83,8 @@ struct Engine::Impl
     std::unique_ptr<Cutscene> _pCutscene;
     sf::Color _fadeColor{sf::Color::Transparent};
     sf::RenderWindow *_pWindow{nullptr};
+    sf::View _view{sf::FloatRect(0, 0, Screen::Width, Screen::Height)};
+    sf::FloatRect _viewport{0, 0, 1, 1};
     sf::Vector2f _cameraPos;
     TextDatabase _textDb;
     Font _fntFont;
@@ -91,14 +120,29 @@ struct Engine::Impl
     int _frameCounter{0};
     std::optional<sf::IntRect> _cameraBounds;
     HSQOBJECT _pDefaultObject;
+    mutable std::optional<VerbsState> _verbsState;
+    mutable SpriteBatch _verbsBatch;
+    bool _showRenderStats{false};
+    bool _isSceneDirty{true};
+    sf::Vector2f _lastCameraPos;
+    sf::Vector2f _previousCameraPos;
+    float _renderInterpolation{1.f};
+    bool _precomputedPaths{false};
+    PathFinderMode _pathFinderMode{PathFinderMode::VisibilityGraph};
+    sf::Vector2f _lastMousePos;
+    sf::Color _lastFadeColor;
+    // last so the workers are stopped before the rest of the engine is destroyed
+    ThreadPool _threadPool{2};
 
     explicit Impl(EngineSettings &settings);
 
     sf::IntRect getVerbRect(int id, std::string lang = "en", bool isRetro = false) const;
-    void drawVerbs(sf::RenderWindow &window) const;
-    void drawCursor(sf::RenderWindow &window) const;
-    void drawCursorText(sf::RenderWindow &window) const;
-    void drawFade(sf::RenderWindow &window) const;
+    void drawVerbs(sf::RenderTarget &target) const;
+    void updateVerbsBatch(const VerbsState &state) const;
+    void drawCursor(sf::RenderTarget &target) const;
+    void drawCursorText(sf::RenderTarget &target) const;
+    void drawFade(sf::RenderTarget &target) const;
+    void drawRenderStats(sf::RenderTarget &target) const;
     void clampCamera();
     int getCurrentActorIndex() const;
     sf::IntRect getCursorRect() const;
@@ -113,6 +157,8 @@ struct Engine::Impl
     SQInteger enterRoom(Room *pRoom, Object *pObject);
     SQInteger exitRoom(Object *pObject);
     void updateScreenSize();
+    void setView(const sf::View &view);
+    void updateSceneDirty();
     void updateRoomScalings();
     void setCurrentRoom(Room *pRoom);
     int32_t getFlags(Actor *pActor);
@@ -122,6 +168,7 @@ Engine::Impl::Impl(EngineSettings &settings)
     : _pEngine(nullptr),
       _settings(settings),
       _textureManager(settings),
+      _costumeManager(_textureManager),
       _pRoom(nullptr),
       _pCutscene(nullptr),
       _pCurrentActor(nullptr),
@@ -138,6 +185,7 @@ Engine::Impl::Impl(EngineSettings &settings)
 {
     _verbSheet.setSettings(&settings);
     _verbSheet.setTextureManager(&_textureManager);
+    _verbsBatch.setTexture(&_verbSheet.getTexture());
     _gameSheet.setSettings(&settings);
     _gameSheet.setTextureManager(&_textureManager);
     sq_resetobject(&_pDefaultObject);
@@ -175,10 +223,36 @@ sf::Vector2f Engine::getCameraAt() const { return _pImpl->_cameraPos; }
 
 void Engine::setWindow(sf::RenderWindow &window) { _pImpl->_pWindow = &window; }
 
+void Engine::showRenderStats(bool show) { _pImpl->_showRenderStats = show; }
+
+bool Engine::isSceneDirty() const { return _pImpl->_isSceneDirty; }
+
+void Engine::setRenderInterpolation(float alpha) { _pImpl->_renderInterpolation = alpha; }
+
+float Engine::getRenderInterpolation() const { return _pImpl->_renderInterpolation; }
+
+bool Engine::areRenderStatsVisible() const { return _pImpl->_showRenderStats; }
+
 const sf::RenderWindow &Engine::getWindow() const { return *_pImpl->_pWindow; }
 
+const sf::View &Engine::getView() const { return _pImpl->_view; }
+
+void Engine::setViewport(const sf::FloatRect &viewport)
+{
+    _pImpl->_viewport = viewport;
+    _pImpl->_view.setViewport(viewport);
+}
+
 TextureManager &Engine::getTextureManager() { return _pImpl->_textureManager; }
 
+CostumeManager &Engine::getCostumeManager() { return _pImpl->_costumeManager; }
+
+AnimationSystem &Engine::getAnimationSystem() { return _pImpl->_animationSystem; }
+
+LipTable &Engine::getLipTable() { return _pImpl->_lipTable; }
+
+ThreadPool &Engine::getThreadPool() { return _pImpl->_threadPool; }
+
 EngineSettings &Engine::getSettings() { return _pImpl->_settings; }
 
 Room *Engine::getRoom() { return _pImpl->_pRoom; }
@@ -193,10 +267,32 @@ void Engine::setFadeColor(sf::Color color) { _pImpl->_fadeColor = color; }
 
 void Engine::addActor(std::unique_ptr<Actor> actor) { _pImpl->_actors.push_back(std::move(actor)); }
 
-void Engine::addRoom(std::unique_ptr<Room> room) { _pImpl->_rooms.push_back(std::move(room)); }
+void Engine::addRoom(std::unique_ptr<Room> room)
+{
+    room->setPathFinderMode(_pImpl->_pathFinderMode);
+    _pImpl->_rooms.push_back(std::move(room));
+}
 
 const std::vector<std::unique_ptr<Room>> &Engine::getRooms() const { return _pImpl->_rooms; }
 
+void Engine::setPrecomputedPaths(bool enabled)
+{
+    _pImpl->_precomputedPaths = enabled;
+    if (enabled && _pImpl->_pRoom)
+    {
+        _pImpl->_pRoom->setPrecomputedPaths(true);
+    }
+}
+
+void Engine::setPathFinderMode(PathFinderMode mode)
+{
+    _pImpl->_pathFinderMode = mode;
+    for (auto &room : _pImpl->_rooms)
+    {
+        room->setPathFinderMode(mode);
+    }
+}
+
 void Engine::addFunction(std::unique_ptr<Function> function) { _pImpl->_newFunctions.push_back(std::move(function)); }
 
 std::vector<std::unique_ptr<Actor>> &Engine::getActors() { return _pImpl->_actors; }
@@ -287,6 +383,12 @@ SQInteger Engine::Impl::exitRoom(Object *pObject)
     return 0;
 }
 
+void Engine::Impl::setView(const sf::View &view)
+{
+    _view = view;
+    _view.setViewport(_viewport);
+}
+
 void Engine::Impl::updateScreenSize()
 {
     if (_pRoom)
@@ -295,7 +397,7 @@ void Engine::Impl::updateScreenSize()
         {
             auto roomSize = _pRoom->getRoomSize();
             sf::View view(sf::FloatRect(0, 0, roomSize.x, roomSize.y));
-            _pWindow->setView(view);
+            setView(view);
         }
         else
         {
@@ -305,19 +407,19 @@ void Engine::Impl::updateScreenSize()
             case 128:
             {
                 sf::View view(sf::FloatRect(0, 0, 320, 180));
-                _pWindow->setView(view);
+                setView(view);
                 break;
             }
             case 172:
             {
                 sf::View view(sf::FloatRect(0, 0, 428, 240));
-                _pWindow->setView(view);
+                setView(view);
                 break;
             }
             case 256:
             {
                 sf::View view(sf::FloatRect(0, 0, 640, 360));
-                _pWindow->setView(view);
+                setView(view);
                 break;
             }
             default:
@@ -325,13 +427,13 @@ void Engine::Impl::updateScreenSize()
                 height = 180.f * height / 128.f;
                 auto ratio = 320.f / 180.f;
                 sf::View view(sf::FloatRect(0, 0, ratio * height, height));
-                _pWindow->setView(view);
+                setView(view);
                 break;
             }
             }
         }
 
-        auto screen = _pWindow->getView().getSize();
+        auto screen = _view.getSize();
         sf::Vector2f size(screen.x / 6.f, screen.y / 14.f);
         for (auto i = 0; i < 9; i++)
         {
@@ -412,6 +514,15 @@ void Engine::Impl::setCurrentRoom(Room *pRoom)
     }
     _cameraBounds = std::nullopt;
     _pRoom = pRoom;
+    if (_pRoom)
+    {
+        _pRoom->setDirty(true);
+        // only the rooms visited are precomputed
+        if (_precomputedPaths)
+        {
+            _pRoom->setPrecomputedPaths(true);
+        }
+    }
     updateScreenSize();
 }
 
@@ -588,7 +699,7 @@ void Engine::Impl::clampCamera()
 
     if (!_pRoom)
         return;
-    auto screen = _pWindow->getView().getSize();
+    auto screen = _view.getSize();
     const auto &size = _pRoom->getRoomSize();
     if (_cameraPos.x > size.x - screen.x)
         _cameraPos.x = size.x - screen.x;
@@ -610,6 +721,10 @@ void Engine::Impl::updateCutscene(const sf::Time &elapsed)
 
 void Engine::Impl::updateFunctions(const sf::Time &elapsed)
 {
+    if (!_newFunctions.empty())
+    {
+        _isSceneDirty = true;
+    }
     for (auto &function : _newFunctions)
     {
         _functions.push_back(std::move(function));
@@ -618,16 +733,52 @@ void Engine::Impl::updateFunctions(const sf::Time &elapsed)
     for (auto &function : _functions)
     {
         (*function)(elapsed);
+        if (!function->isIdle())
+        {
+            _isSceneDirty = true;
+        }
     }
+    auto size = _functions.size();
     _functions.erase(std::remove_if(_functions.begin(), _functions.end(),
                                     [](std::unique_ptr<Function> &f) { return f->isElapsed(); }),
                      _functions.end());
+    if (size != _functions.size())
+    {
+        _isSceneDirty = true;
+    }
+    _animationSystem.update(elapsed);
     for (auto &actor : _actors)
     {
         actor->update(elapsed);
     }
 }
 
+void Engine::Impl::updateSceneDirty()
+{
+    if (_pRoom->isDirty())
+    {
+        _pRoom->setDirty(false);
+        _isSceneDirty = true;
+    }
+    if (_pCutscene || _dialogManager.isActive() || _actorIcons.isAnimating())
+    {
+        _isSceneDirty = true;
+    }
+    if (_cameraPos != _lastCameraPos || _mousePos != _lastMousePos || _fadeColor != _lastFadeColor)
+    {
+        _lastCameraPos = _cameraPos;
+        _lastMousePos = _mousePos;
+        _lastFadeColor = _fadeColor;
+        _isSceneDirty = true;
+    }
+    if (_isSceneDirty)
+        return;
+
+    _isSceneDirty = std::any_of(_actors.begin(), _actors.end(), [this](const std::unique_ptr<Actor> &actor) {
+        return actor->getRoom() == _pRoom && (actor->isWalking() || actor->isTalking());
+    });
+}
+
 void Engine::Impl::updateActorIcons(const sf::Time &elapsed)
 {
     _actorIcons.setMousePosition(_mousePos);
@@ -636,7 +787,7 @@ void Engine::Impl::updateActorIcons(const sf::Time &elapsed)
 
 void Engine::Impl::updateMouseCursor()
 {
-    auto screen = _pWindow->getView().getSize();
+    auto screen = _view.getSize();
     if (_mousePos.x < 20)
         _cursorDirection |= CursorDirection::Left;
     else if (_mousePos.x > screen.x - 20)
@@ -742,17 +893,28 @@ void Engine::update(const sf::Time &elapsed)
     auto isMouseClick = wasMouseDown != _pImpl->_isMouseDown && !_pImpl->_isMouseDown;
 
     _pImpl->_time += elapsed;
+    _pImpl->_previousCameraPos = _pImpl->_cameraPos;
+    _pImpl->_isSceneDirty = wasMouseDown != _pImpl->_isMouseDown || wasMouseRightDown != _pImpl->_isMouseRightDown;
 
     _pImpl->updateCutscene(elapsed);
-    _pImpl->updateFunctions(elapsed);
+    {
+        RenderStatsTimer timer(RenderStatsPhase::UpdateFunctions);
+        _pImpl->updateFunctions(elapsed);
+    }
 
     if (!_pImpl->_pRoom)
+    {
+        _pImpl->_isSceneDirty = true;
         return;
+    }
 
     _pImpl->updateRoomScalings();
 
-    auto screen = _pImpl->_pWindow->getView().getSize();
-    _pImpl->_pRoom->update(elapsed);
+    auto screen = _pImpl->_view.getSize();
+    {
+        RenderStatsTimer timer(RenderStatsPhase::UpdateRoom);
+        _pImpl->_pRoom->update(elapsed);
+    }
     if (_pImpl->_pFollowActor && _pImpl->_pFollowActor->isVisible())
     {
         auto pos = _pImpl->_pFollowActor->getPosition();
@@ -760,7 +922,7 @@ void Engine::update(const sf::Time &elapsed)
         _pImpl->clampCamera();
     }
 
-    _pImpl->_mousePos = _pImpl->_pWindow->mapPixelToCoords(sf::Mouse::getPosition(*_pImpl->_pWindow));
+    _pImpl->_mousePos = _pImpl->_pWindow->mapPixelToCoords(sf::Mouse::getPosition(*_pImpl->_pWindow), _pImpl->_view);
     _pImpl->updateActorIcons(elapsed);
 
     _pImpl->_cursorDirection = CursorDirection::None;
@@ -768,12 +930,25 @@ void Engine::update(const sf::Time &elapsed)
 
     auto mousePosInRoom = _pImpl->_mousePos + _pImpl->_cameraPos;
 
-    _pImpl->updateCurrentObject(mousePosInRoom);
-    _pImpl->updateCurrentActor(mousePosInRoom);
+    {
+        RenderStatsTimer timer(RenderStatsPhase::UpdateCurrentObject);
+        _pImpl->updateCurrentObject(mousePosInRoom);
+    }
+    {
+        RenderStatsTimer timer(RenderStatsPhase::UpdateCurrentActor);
+        _pImpl->updateCurrentActor(mousePosInRoom);
+    }
 
     _pImpl->_inventory.setMousePosition(_pImpl->_mousePos);
-    _pImpl->_inventory.update(elapsed);
-    _pImpl->_dialogManager.update(elapsed);
+    {
+        RenderStatsTimer timer(RenderStatsPhase::UpdateInventory);
+        _pImpl->_inventory.update(elapsed);
+    }
+    {
+        RenderStatsTimer timer(RenderStatsPhase::UpdateDialog);
+        _pImpl->_dialogManager.update(elapsed);
+    }
+    _pImpl->updateSceneDirty();
 
     if (!_pImpl->_inputActive)
         return;
@@ -911,42 +1086,108 @@ bool Engine::Impl::clickedAt(const sf::Vector2f &pos)
     return false;
 }
 
-void Engine::draw(sf::RenderWindow &window) const
+void Engine::draw(sf::RenderTarget &target) const
 {
     if (!_pImpl->_pRoom)
         return;
 
-    _pImpl->_pRoom->draw(window, _pImpl->_cameraPos);
+    {
+        RenderStatsTimer timer(RenderStatsPhase::Draw);
+        drawScene(target);
+    }
+
+    if (_pImpl->_showRenderStats)
+    {
+        _pImpl->drawRenderStats(target);
+    }
+}
+
+void Engine::drawScene(sf::RenderTarget &target) const
+{
+    auto cameraPos = interpolate(_pImpl->_previousCameraPos, _pImpl->_cameraPos, _pImpl->_renderInterpolation);
+    _pImpl->_pRoom->draw(target, cameraPos);
 
-    window.draw(_pImpl->_dialogManager);
+    target.draw(_pImpl->_dialogManager);
 
     if (!_pImpl->_dialogManager.isActive() && _pImpl->_inputActive)
     {
-        _pImpl->drawVerbs(window);
-        window.draw(_pImpl->_inventory);
-        window.draw(_pImpl->_actorIcons);
+        _pImpl->drawVerbs(target);
+        target.draw(_pImpl->_inventory);
+        target.draw(_pImpl->_actorIcons);
     }
 
-    _pImpl->drawFade(window);
-    _pImpl->drawCursor(window);
-    _pImpl->drawCursorText(window);
+    _pImpl->drawFade(target);
+    _pImpl->drawCursor(target);
+    _pImpl->drawCursorText(target);
 }
 
-void Engine::Impl::drawFade(sf::RenderWindow &window) const
+void Engine::Impl::drawFade(sf::RenderTarget &target) const
 {
     sf::RectangleShape fadeShape;
-    auto screen = _pWindow->getView().getSize();
+    auto screen = _view.getSize();
     fadeShape.setSize(sf::Vector2f(screen.x, screen.y));
     fadeShape.setFillColor(_fadeColor);
-    window.draw(fadeShape);
+    target.draw(fadeShape);
+    RenderStats::get().addDrawCall(nullptr, fadeShape.getPointCount() + 2);
 }
 
-void Engine::Impl::drawCursor(sf::RenderWindow &window) const
+void Engine::Impl::drawRenderStats(sf::RenderTarget &target) const
+{
+    const auto &stats = RenderStats::get().getLastFrame();
+    std::vector<std::wstring> lines;
+    std::wstringstream s;
+    s << L"draw calls: " << stats.drawCalls << L" vertices: " << stats.vertices;
+    lines.push_back(s.str());
+    s.str(L"");
+    s << L"texture switches: " << stats.textureSwitches << L" culled: " << stats.spritesCulled
+      << L" uploads: " << stats.textureUploads;
+    lines.push_back(s.str());
+    for (size_t i = 0; i < static_cast<size_t>(RenderStatsPhase::Count); i++)
+    {
+        s.str(L"");
+        s << towstring(RenderStats::getPhaseName(static_cast<RenderStatsPhase>(i))) << L": " << std::fixed
+          << std::setprecision(2) << stats.times[i].asMicroseconds() / 1000.f << L" ms";
+        lines.push_back(s.str());
+    }
+    s.str(L"");
+    s << L"frames presented: " << RenderStats::get().getFramesPresented() << L" skipped: "
+      << RenderStats::get().getFramesSkipped();
+    lines.push_back(s.str());
+    if (_pScriptExecute)
+    {
+        const auto &scriptStats = _pScriptExecute->getStats();
+        s.str(L"");
+        s << L"scripts compiled: " << scriptStats.compiles << L" ("
+          << std::chrono::duration<float, std::milli>(scriptStats.compileTime).count() << L" ms) cached: "
+          << scriptStats.cacheHits << L" (" << std::chrono::duration<float, std::milli>(scriptStats.cacheHitTime).count()
+          << L" ms)";
+        lines.push_back(s.str());
+    }
+    if (RenderStats::get().isCsvActive())
+    {
+        lines.emplace_back(L"recording csv");
+    }
+
+    NGText text;
+    text.setFont(_fntFont);
+    text.setColor(sf::Color::Yellow);
+    text.setAlignment(NGTextAlignment::Left);
+    float y = 2;
+    for (const auto &line : lines)
+    {
+        text.setText(line);
+        text.setPosition(2, y);
+        target.draw(text, sf::RenderStates::Default);
+        y += text.getBoundRect().height + 1;
+    }
+}
+
+void Engine::Impl::drawCursor(sf::RenderTarget &target) const
 {
     if (!_inputActive)
         return;
 
-    auto screen = _pWindow->getView().getSize();
+    auto screen = _view.getSize();
     auto cursorSize = sf::Vector2f(68.f * screen.x / 1284, 68.f * screen.y / 772);
     sf::RectangleShape shape;
     shape.setPosition(_mousePos);
@@ -955,13 +1196,14 @@ void Engine::Impl::drawCursor(sf::RenderWindow &window) const
     shape.setTexture(&_gameSheet.getTexture());
 
     shape.setTextureRect(getCursorRect());
-    window.draw(shape);
+    target.draw(shape);
+    RenderStats::get().addDrawCall(shape.getTexture(), shape.getPointCount() + 2);
 }
 
 sf::IntRect Engine::Impl::getCursorRect() const
 {
     const auto &size = _pRoom->getRoomSize();
-    auto screen = _pWindow->getView().getSize();
+    auto screen = _view.getSize();
     if (_cursorDirection & CursorDirection::Left && _cameraPos.x > 0)
     {
         return _cursorDirection & CursorDirection::Hotspot ? _gameSheet.getRect("hotspot_cursor_left")
@@ -985,7 +1227,7 @@ sf::IntRect Engine::Impl::getCursorRect() const
     return _cursorDirection & CursorDirection::Hotspot ? _gameSheet.getRect("hotspot_cursor") : _gameSheet.getRect("cursor");
 }
 
-void Engine::Impl::drawCursorText(sf::RenderWindow &window) const
+void Engine::Impl::drawCursorText(sf::RenderTarget &target) const
 {
     if (!_inputActive)
         return;
@@ -1045,7 +1287,7 @@ void Engine::Impl::drawCursorText(sf::RenderWindow &window) const
 
         sf::RenderStates states;
         states.transform.translate(-_cameraPos);
-        _pCurrentObject->drawHotspot(window, states);
+        _pCurrentObject->drawHotspot(target, states);
     }
     else
     {
@@ -1072,13 +1314,13 @@ void Engine::Impl::drawCursorText(sf::RenderWindow &window) const
     // s << txt << L" (" << std::fixed << std::setprecision(0) << mousePosInRoom.x << L"," << mousePosInRoom.y << L")";
     // text.setText(s.str());
 
-    auto screen = _pWindow->getView().getSize();
+    auto screen = _view.getSize();
     auto y = _mousePos.y - 22 < 8 ? _mousePos.y + 8 : _mousePos.y - 22;
     if (y < 0)
         y = 0;
     auto x = std::clamp((int)_mousePos.x, 20, (int)screen.x - 20 - (int)text.getBoundRect().width / 2);
     text.setPosition(x, y);
-    window.draw(text, sf::RenderStates::Default);
+    target.draw(text, sf::RenderStates::Default);
 }
 
 void Engine::Impl::appendUseFlag(std::wstring &sentence) const
@@ -1112,7 +1354,7 @@ int Engine::Impl::getCurrentActorIndex() const
     return -1;
 }
 
-void Engine::Impl::drawVerbs(sf::RenderWindow &window) const
+void Engine::Impl::drawVerbs(sf::RenderTarget &target) const
 {
     if (!_inputVerbsActive)
         return;
@@ -1139,10 +1381,31 @@ void Engine::Impl::drawVerbs(sf::RenderWindow &window) const
         }
     }
 
-    sf::RenderStates states;
-    states.texture = &_verbSheet.getTexture();
+    VerbsState state;
+    state.actorIndex = currentActorIndex;
+    state.verbId = verbId;
+    state.screen = _view.getSize();
+    for (auto i = 0; i < 9; i++)
+    {
+        state.verbIds.at(i) = _verbSlots.at(currentActorIndex).getVerb(i + 1).id;
+    }
+    state.normalTint = _verbUiColors.at(currentActorIndex).verbNormalTint;
+    state.highlight = _verbUiColors.at(currentActorIndex).verbHighlight;
+
+    // the panel geometry only changes with the actor, the hovered verb, the colors or the screen size
+    if (!_verbsState || !(*_verbsState == state))
+    {
+        updateVerbsBatch(state);
+        _verbsState = state;
+    }
+    target.draw(_verbsBatch);
+}
+
+void Engine::Impl::updateVerbsBatch(const VerbsState &state) const
+{
+    _verbsBatch.clear();
 
-    auto screen = _pWindow->getView().getSize();
+    auto screen = state.screen;
     sf::Vector2f size(screen.x / 6.f, screen.y / 14.f);
     auto ratio = sf::Vector2f(screen.x / 1280.f, screen.y / 720.f);
     for (int x = 0; x < 3; x++)
@@ -1150,8 +1413,7 @@ void Engine::Impl::drawVerbs(sf::RenderWindow &window) const
         auto maxW = 0;
         for (int y = 0; y < 3; y++)
         {
-            auto verb = _verbSlots.at(currentActorIndex).getVerb(x * 3 + y + 1);
-            auto rect = getVerbRect(verb.id);
+            auto rect = getVerbRect(state.verbIds.at(x * 3 + y));
             maxW = fmax(maxW, rect.width * ratio.x);
         }
         auto padding = (size.x - maxW) / 2.f;
@@ -1160,19 +1422,16 @@ void Engine::Impl::drawVerbs(sf::RenderWindow &window) const
         for (int y = 0; y < 3; y++)
         {
             auto top = screen.y - size.y * 3 + y * size.y;
-            auto verb = _verbSlots.at(currentActorIndex).getVerb(x * 3 + y + 1);
-            auto rect = getVerbRect(verb.id);
-            auto verbSize = sf::Vector2f(rect.width * ratio.x, rect.height * ratio.y);
             int index = x * 3 + y;
-            auto color = index == verbId ? _verbUiColors.at(currentActorIndex).verbHighlight
-                                         : _verbUiColors.at(currentActorIndex).verbNormalTint;
+            auto rect = getVerbRect(state.verbIds.at(index));
+            auto verbSize = sf::Vector2f(rect.width * ratio.x, rect.height * ratio.y);
+            auto color = index == state.verbId ? state.highlight : state.normalTint;
             sf::RectangleShape verbShape;
             verbShape.setFillColor(color);
             verbShape.setPosition(left, top);
             verbShape.setSize(verbSize);
-            verbShape.setTexture(&_verbSheet.getTexture());
             verbShape.setTextureRect(rect);
-            window.draw(verbShape);
+            _verbsBatch.add(verbShape);
         }
     }
 }
@@ -68,7 +68,7 @@ void Entity::trig(int triggerNumber)
     }
 }
 
-void Entity::trigSound(const std::string &name)
+void Entity::trigSound(int soundTrigger)
 {
 }
 
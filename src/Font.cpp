@@ -1,5 +1,6 @@
 #include <fstream>
 #include "Font.h"
+#include "RenderStats.h"
 #include "_NGUtil.h"
 
 namespace ng
@@ -91,6 +92,7 @@ void NGText::draw(sf::RenderTarget &target, sf::RenderStates states) const
         _sprite.setColor(_color);
         _sprite.setPosition(x, 0);
         target.draw(_sprite, states);
+        RenderStats::get().addDrawCall(&_font.getTexture(), 4);
         x += std::max(rect.width * scale, 10.f * scale);
     }
 }
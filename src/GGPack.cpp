@@ -265,6 +265,14 @@ bool GGPack::hasEntry(const std::string &name)
     return _entries.find(name) != _entries.end();
 }
 
+void GGPack::getEntries(std::vector<std::string> &names) const
+{
+    for (const auto &entry : _entries)
+    {
+        names.push_back(entry.first);
+    }
+}
+
 void GGPack::readEntry(const std::string &name, std::vector<char> &data)
 {
     auto entry = _entries[name];
@@ -1,13 +1,26 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
 #include "Game.h"
+#include "RenderStats.h"
 #include "Screen.h"
 
 namespace ng
 {
+namespace
+{
+const unsigned int FrameRate = 60;
+// above, a tick is shorter than the microsecond resolution of sf::Time
+const int MaxTickRate = 1000;
+// even when idle, the screen is refreshed at this interval
+const sf::Time IdleRefreshTime = sf::seconds(1);
+} // namespace
+
 Game::Game(Engine &engine)
     : _engine(engine), _window(sf::VideoMode(Screen::Width, Screen::Height), "Engge")
 {
     _window.setSize(sf::Vector2u(1024, 768));
-    _window.setFramerateLimit(60);
+    _window.setFramerateLimit(FrameRate);
     _window.setMouseCursorVisible(false);
     _engine.setWindow(_window);
 }
@@ -20,17 +33,34 @@ void Game::run()
     while (_window.isOpen())
     {
         sf::Time elapsed = clock.restart();
-        update(elapsed);
-        processEvents();
-        render();
+        RenderStats::get().beginFrame();
+        updateTicks(elapsed);
+        auto hasEvents = processEvents();
+
+        auto present = !_idleFrameSkipping || hasEvents || _isSceneDirty ||
+                       _presentClock.getElapsedTime() >= IdleRefreshTime;
+        RenderStats::get().setPresented(present);
+        if (present)
+        {
+            render();
+            _presentClock.restart();
+        }
+        else
+        {
+            // display() is skipped so the frame rate limit has to be applied here
+            sf::sleep(sf::seconds(1.f / FrameRate) - clock.getElapsedTime());
+        }
+        RenderStats::get().endFrame();
     }
 }
 
-void Game::processEvents()
+bool Game::processEvents()
 {
+    auto hasEvents = false;
     sf::Event event{};
     while (_window.pollEvent(event))
     {
+        hasEvents = true;
         for (auto &eh : _inputEventHandlers)
         {
             eh->run(event);
@@ -50,6 +80,52 @@ void Game::processEvents()
             break;
         }
     }
+    return hasEvents;
+}
+
+void Game::setTickRate(int ticksPerSecond)
+{
+    if (ticksPerSecond <= 0)
+    {
+        std::cerr << "Invalid tick rate: " << ticksPerSecond << std::endl;
+        return;
+    }
+    if (ticksPerSecond > MaxTickRate)
+    {
+        std::cerr << "Tick rate " << ticksPerSecond << " clamped to " << MaxTickRate << std::endl;
+        ticksPerSecond = MaxTickRate;
+    }
+    _tickTime = sf::seconds(1.f / ticksPerSecond);
+    assert(_tickTime > sf::Time::Zero);
+}
+
+void Game::updateTicks(const sf::Time &elapsed)
+{
+    assert(_tickTime > sf::Time::Zero);
+    _accumulator += elapsed;
+    auto maxTime = _tickTime * static_cast<sf::Int64>(_maxTicksPerFrame);
+    if (_accumulator > maxTime)
+    {
+        _accumulator = maxTime;
+    }
+
+    auto isUpdated = false;
+    auto isSceneDirty = false;
+    while (_accumulator >= _tickTime)
+    {
+        update(_tickTime);
+        _accumulator -= _tickTime;
+        isSceneDirty |= _engine.isSceneDirty();
+        isUpdated = true;
+    }
+
+    // renders between the last two updates with the time left in the accumulator
+    _engine.setRenderInterpolation(_accumulator / _tickTime);
+    // without any update the last state is kept, an interpolated movement still needs to be rendered
+    if (isUpdated)
+    {
+        _isSceneDirty = isSceneDirty;
+    }
 }
 
 void Game::update(const sf::Time &elapsed)
@@ -57,10 +133,78 @@ void Game::update(const sf::Time &elapsed)
     _engine.update(elapsed);
 }
 
+RenderMode Game::parseRenderMode(const std::string &mode)
+{
+    if (mode == "native")
+        return RenderMode::Native;
+    if (mode == "integer")
+        return RenderMode::NativeInteger;
+    if (mode != "window")
+    {
+        std::cerr << "Unknown render mode: " << mode << std::endl;
+    }
+    return RenderMode::Window;
+}
+
 void Game::render()
 {
+    if (_renderMode != RenderMode::Window)
+    {
+        renderNative();
+        return;
+    }
+
+    _engine.setViewport(sf::FloatRect(0, 0, 1, 1));
+    _window.setView(_engine.getView());
     _window.clear();
     _engine.draw(_window);
     _window.display();
 }
+
+void Game::renderNative()
+{
+    // the scene is rasterized once at the size of the virtual screen of the room and upscaled in a single pass
+    const auto &view = _engine.getView();
+    auto screen = view.getSize();
+    sf::Vector2u nativeSize(static_cast<unsigned int>(std::ceil(screen.x)), static_cast<unsigned int>(std::ceil(screen.y)));
+    if (_renderTexture.getSize() != nativeSize)
+    {
+        if (!_renderTexture.create(nativeSize.x, nativeSize.y))
+        {
+            std::cerr << "Failed to create the native render target, fallback to window rendering" << std::endl;
+            _renderMode = RenderMode::Window;
+            render();
+            return;
+        }
+        _renderTexture.setSmooth(false);
+    }
+
+    auto windowSize = sf::Vector2f(_window.getSize());
+    auto scale = sf::Vector2f(windowSize.x / nativeSize.x, windowSize.y / nativeSize.y);
+    if (_renderMode == RenderMode::NativeInteger)
+    {
+        auto factor = std::max(1.f, std::floor(std::min(scale.x, scale.y)));
+        scale = sf::Vector2f(factor, factor);
+    }
+    auto size = sf::Vector2f(nativeSize.x * scale.x, nativeSize.y * scale.y);
+    auto pos = sf::Vector2f(std::floor((windowSize.x - size.x) / 2.f), std::floor((windowSize.y - size.y) / 2.f));
+
+    // keep the viewport in sync with the upscaled image so the mouse position is mapped correctly
+    _engine.setViewport(sf::FloatRect(pos.x / windowSize.x, pos.y / windowSize.y, size.x / windowSize.x, size.y / windowSize.y));
+
+    _renderTexture.setView(sf::View(view.getCenter(), view.getSize()));
+    _renderTexture.clear();
+    _engine.draw(_renderTexture);
+    _renderTexture.display();
+
+    sf::Sprite sprite(_renderTexture.getTexture());
+    sprite.setPosition(pos);
+    sprite.setScale(scale);
+
+    _window.setView(sf::View(sf::FloatRect(0, 0, windowSize.x, windowSize.y)));
+    _window.clear();
+    _window.draw(sprite);
+    RenderStats::get().addDrawCall(sprite.getTexture(), 4);
+    _window.display();
+}
 } // namespace ng
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <utility>
 
 #include "Graph.h"
@@ -20,57 +21,64 @@ std::ostream &operator<<(std::ostream &os, const GraphEdge &edge)
 
 Graph::Graph() = default;
 
-Graph::Graph(const Graph &graph)
-    : nodes(graph.nodes), edges(graph.edges), concaveVertices(graph.concaveVertices)
+int Graph::addNode(sf::Vector2i node)
 {
+    nodes.push_back(node);
+    _offsets.push_back(static_cast<uint32_t>(_arcs.size()));
+    return static_cast<int>(nodes.size() - 1);
 }
 
-std::shared_ptr<GraphEdge> Graph::getEdge(int from, int to)
+void Graph::addEdge(const GraphEdge &edge)
 {
-    for (auto &e : edges[from])
-    {
-        if (e->to == to)
-        {
-            return e;
-        }
-    }
-    return nullptr;
+    // an edge to itself never shortens a path
+    if (edge.from == edge.to)
+        return;
+    _edges.push_back(edge);
 }
 
-int Graph::addNode(sf::Vector2i node)
+void Graph::freeze()
 {
-    nodes.push_back(node);
-    edges.emplace_back();
-    return 0;
-}
+    // the edges of a row are sorted by destination, a stable sort keeps the first of the duplicated edges
+    std::stable_sort(_edges.begin(), _edges.end(), [](const GraphEdge &e1, const GraphEdge &e2) {
+        return e1.from != e2.from ? e1.from < e2.from : e1.to < e2.to;
+    });
+    _edges.erase(std::unique(_edges.begin(), _edges.end(), [](const GraphEdge &e1, const GraphEdge &e2) {
+                     return e1.from == e2.from && e1.to == e2.to;
+                 }),
+                 _edges.end());
 
-void Graph::addEdge(const std::shared_ptr<GraphEdge>& edge)
-{
-    if (getEdge(edge->from, edge->to) == nullptr)
+    _offsets.assign(nodes.size() + 1, 0);
+    _arcs.clear();
+    _arcs.reserve(_edges.size());
+    for (const auto &edge : _edges)
     {
-        edges[edge->from].push_back(edge);
+        _offsets[edge.from + 1]++;
+        _arcs.push_back({static_cast<uint32_t>(edge.to), edge.cost});
     }
-    if (getEdge(edge->to, edge->from) == nullptr)
+    for (size_t i = 1; i < _offsets.size(); i++)
     {
-        edges[edge->to].push_back(edge);
+        _offsets[i] += _offsets[i - 1];
     }
+    _edges.clear();
+    _edges.shrink_to_fit();
 }
 
 void Graph::draw(sf::RenderTarget &window, sf::RenderStates states) const
 {
     sf::Color color(180, 180, 250);
     std::vector<sf::Vertex> vertices;
-    for (const auto& edge : edges)
+    for (int from = 0; from < static_cast<int>(nodes.size()); from++)
     {
-        for (const auto& e : edge)
+        for (auto it = beginEdges(from); it != endEdges(from); ++it)
         {
-            auto &nodeFrom = nodes[e->from];
-            auto &nodeTo = nodes[e->to];
-            vertices.emplace_back((sf::Vector2f)nodeFrom, color);
-            vertices.emplace_back((sf::Vector2f)nodeTo, color);
+            vertices.emplace_back((sf::Vector2f)nodes[from], color);
+            vertices.emplace_back((sf::Vector2f)nodes[it->to], color);
         }
     }
-    window.draw(&vertices[0], vertices.size(), sf::Lines, states);
+    if (!vertices.empty())
+    {
+        window.draw(&vertices[0], vertices.size(), sf::Lines, states);
+    }
 
     for (auto node : nodes)
     {
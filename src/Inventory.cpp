@@ -25,6 +25,9 @@ void Inventory::setEngine(Engine *pEngine)
     _inventoryItems.setTextureManager(&_pEngine->getTextureManager());
     _inventoryItems.setSettings(&_pEngine->getSettings());
     _inventoryItems.load("InventoryItems");
+
+    _backgroundBatch.setTexture(&_gameSheet.getTexture());
+    _itemsBatch.setTexture(&_inventoryItems.getTexture());
 }
 
 void Inventory::update(const sf::Time &elapsed)
@@ -33,7 +36,7 @@ void Inventory::update(const sf::Time &elapsed)
         return;
     _pCurrentInventoryObject = nullptr;
 
-    auto screen = _pEngine->getWindow().getView().getSize();
+    auto screen = _pEngine->getView().getSize();
     // inventory rects
     auto x = 0, y = 0;
     auto ratio = sf::Vector2f(screen.x / 1280.f, screen.y / 720.f);
@@ -80,52 +83,85 @@ int Inventory::getCurrentActorIndex() const
     return -1;
 }
 
-void Inventory::drawUpArrow(sf::RenderTarget &target) const
+bool Inventory::State::operator==(const State &other) const
 {
-    auto screen = _pEngine->getWindow().getView().getSize();
+    return actorIndex == other.actorIndex && screen == other.screen && background == other.background &&
+           arrows == other.arrows && icons == other.icons;
+}
+
+void Inventory::addUpArrow(const State &state) const
+{
+    auto screen = state.screen;
     auto ratio = sf::Vector2f(screen.x / 1280.f, screen.y / 720.f);
 
-    int currentActorIndex = getCurrentActorIndex();
     auto rect = _gameSheet.getRect("scroll_up");
 
     sf::Vector2f scrollUpSize(rect.width * ratio.x, rect.height * ratio.y);
     sf::Vector2f scrollUpPosition(screen.x / 2.f, screen.y - 3 * screen.y / 14.f);
     sf::RectangleShape scrollUpShape;
-    scrollUpShape.setFillColor(_verbUiColors.at(currentActorIndex).verbNormal);
+    scrollUpShape.setFillColor(state.arrows);
     scrollUpShape.setPosition(scrollUpPosition);
     scrollUpShape.setSize(scrollUpSize);
-    scrollUpShape.setTexture(&_gameSheet.getTexture());
     scrollUpShape.setTextureRect(rect);
-    target.draw(scrollUpShape);
+    _backgroundBatch.add(scrollUpShape);
 }
 
-void Inventory::drawDownArrow(sf::RenderTarget &target) const
+void Inventory::addDownArrow(const State &state) const
 {
-    auto screen = _pEngine->getWindow().getView().getSize();
+    auto screen = state.screen;
     auto ratio = sf::Vector2f(screen.x / 1280.f, screen.y / 768.f);
 
-    int currentActorIndex = getCurrentActorIndex();
     auto scrollUpFrameRect = _gameSheet.getRect("scroll_up");
     sf::Vector2f scrollUpPosition(screen.x / 2.f, screen.y - 3 * screen.y / 14.f);
     sf::Vector2f scrollUpSize(scrollUpFrameRect.width * ratio.x, scrollUpFrameRect.height * ratio.y);
 
     auto scrollDownFrameRect = _gameSheet.getRect("scroll_down");
     sf::RectangleShape scrollDownShape;
-    scrollDownShape.setFillColor(_verbUiColors.at(currentActorIndex).verbNormal);
+    scrollDownShape.setFillColor(state.arrows);
     scrollDownShape.setPosition(scrollUpPosition.x, scrollUpPosition.y + scrollUpFrameRect.height * ratio.y);
     scrollDownShape.setSize(scrollUpSize);
-    scrollDownShape.setTexture(&_gameSheet.getTexture());
     scrollDownShape.setTextureRect(scrollDownFrameRect);
-    target.draw(scrollDownShape);
+    _backgroundBatch.add(scrollDownShape);
 }
 
 void Inventory::draw(sf::RenderTarget &target, sf::RenderStates states) const
 {
-    auto screen = _pEngine->getWindow().getView().getSize();
     int currentActorIndex = getCurrentActorIndex();
     if (currentActorIndex == -1)
         return;
 
+    State state;
+    state.actorIndex = currentActorIndex;
+    state.screen = _pEngine->getView().getSize();
+    state.background = _verbUiColors.at(currentActorIndex).inventoryBackground;
+    state.arrows = _verbUiColors.at(currentActorIndex).verbNormal;
+    if (_pCurrentActor)
+    {
+        for (const auto &object : _pCurrentActor->getObjects())
+        {
+            if (state.icons.size() == 8)
+                break;
+            state.icons.push_back(object->getIcon());
+        }
+    }
+
+    // rebuild the geometry only when the actor, its inventory, its colors or the screen size change
+    if (!_state || !(*_state == state))
+    {
+        updateBatches(state);
+        _state = state;
+    }
+
+    target.draw(_backgroundBatch, states);
+    target.draw(_itemsBatch, states);
+}
+
+void Inventory::updateBatches(const State &state) const
+{
+    _backgroundBatch.clear();
+    _itemsBatch.clear();
+
+    auto screen = state.screen;
     auto ratio = sf::Vector2f(screen.x / 1280.f, screen.y / 720.f);
 
     // inventory arrows
@@ -135,10 +171,9 @@ void Inventory::draw(sf::RenderTarget &target, sf::RenderStates states) const
 
     auto inventoryFrameRect = _gameSheet.getRect("inventory_background");
     sf::RectangleShape inventoryShape;
-    sf::Color c(_verbUiColors.at(currentActorIndex).inventoryBackground);
+    sf::Color c(state.background);
     c.a = 128;
     inventoryShape.setFillColor(c);
-    inventoryShape.setTexture(&_gameSheet.getTexture());
     inventoryShape.setTextureRect(inventoryFrameRect);
     auto sizeBack = sf::Vector2f(206.f * screen.x / 1920.f, 112.f * screen.y / 1080.f);
     inventoryShape.setSize(sizeBack);
@@ -149,34 +184,28 @@ void Inventory::draw(sf::RenderTarget &target, sf::RenderStates states) const
         auto x = (i % 4) * (sizeBack.x + gapX);
         auto y = (i / 4) * (sizeBack.y + gapY);
         inventoryShape.setPosition(sf::Vector2f(scrollUpPosition.x + scrollUpSize.x + x, y + screen.y - 3 * screen.y / 14.f));
-        target.draw(inventoryShape);
+        _backgroundBatch.add(inventoryShape);
     }
 
-    // draw inventory objects
-    if (!_pCurrentActor)
-        return;
-
+    // inventory objects
     auto startX = sizeBack.x / 2.f + scrollUpPosition.x + scrollUpSize.x;
     auto startY = sizeBack.y / 2.f + screen.y - 3 * screen.y / 14.f;
 
     auto x = 0, y = 0;
     int i = 0;
-    auto &objects = _pCurrentActor->getObjects();
-    for (const auto &object : objects)
+    for (const auto &icon : state.icons)
     {
-        auto icon = object->getIcon();
         auto rect = _inventoryItems.getRect(icon);
         auto spriteSourceSize = _inventoryItems.getSpriteSourceSize(icon);
         auto sourceSize = _inventoryItems.getSourceSize(icon);
         sf::Vector2f origin(-sourceSize.x / 2.f + spriteSourceSize.left, -sourceSize.y / 2.f + spriteSourceSize.top);
 
-        sf::RectangleShape inventoryShape;
-        inventoryShape.setOrigin(-origin);
-        inventoryShape.setPosition(sf::Vector2f(x + startX, y + startY));
-        inventoryShape.setSize(sf::Vector2f(rect.width, rect.height));
-        inventoryShape.setTexture(&_inventoryItems.getTexture());
-        inventoryShape.setTextureRect(rect);
-        target.draw(inventoryShape);
+        sf::RectangleShape itemShape;
+        itemShape.setOrigin(-origin);
+        itemShape.setPosition(sf::Vector2f(x + startX, y + startY));
+        itemShape.setSize(sf::Vector2f(rect.width, rect.height));
+        itemShape.setTextureRect(rect);
+        _itemsBatch.add(itemShape);
         i++;
         if (i == 8)
             break;
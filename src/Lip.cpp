@@ -1,13 +1,187 @@
-#include <regex>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
 #include "Lip.h"
-#include "_NGUtil.h"
 
 namespace ng
 {
+static const char LipTableMagic[4] = {'N', 'G', 'L', 'P'};
+// incremented each time the layout of the table changes, an older table is parsed again
+static const uint32_t LipTableVersion = 1;
+// a lip data is saved as a time and a letter
+static const uint64_t LipDataSize = sizeof(float) + 1;
+
+// parses a line with the format: time whitespaces letter
+static bool _parseLipLine(const char *begin, const char *end, NGLipData &data)
+{
+    auto p = begin;
+    while (p != end && std::isdigit(static_cast<unsigned char>(*p)))
+        p++;
+    if (p != end && *p == '.')
+        p++;
+    while (p != end && std::isdigit(static_cast<unsigned char>(*p)))
+        p++;
+    auto timeEnd = p;
+
+    if (p == end || !std::isspace(static_cast<unsigned char>(*p)))
+        return false;
+    while (p != end && std::isspace(static_cast<unsigned char>(*p)))
+        p++;
+
+    if (p == end || !(std::isalnum(static_cast<unsigned char>(*p)) || *p == '_'))
+        return false;
+    auto letter = *p++;
+    if (p != end && *p == '\r')
+        p++;
+    if (p != end)
+        return false;
+
+    std::string time(begin, timeEnd);
+    data.time = sf::seconds(std::strtof(time.c_str(), nullptr));
+    data.letter = letter;
+    return true;
+}
+
+static std::shared_ptr<const NGLipTrack> _parseLip(const std::vector<char> &buffer)
+{
+    auto track = std::make_shared<NGLipTrack>();
+    auto p = buffer.data();
+    auto end = p + buffer.size();
+    while (p != end)
+    {
+        auto lineEnd = p;
+        while (lineEnd != end && *lineEnd != '\n' && *lineEnd != 0)
+            lineEnd++;
+        NGLipData data{};
+        if (_parseLipLine(p, lineEnd, data))
+        {
+            track->push_back(data);
+        }
+        p = lineEnd == end ? end : lineEnd + 1;
+    }
+    return track;
+}
+
+std::shared_ptr<const NGLipTrack> LipTable::get(const std::string &name) const
+{
+    auto it = _tracks.find(name);
+    if (it == _tracks.end())
+        return nullptr;
+    return it->second;
+}
+
+void LipTable::add(const std::string &name, std::shared_ptr<const NGLipTrack> track)
+{
+    _tracks[name] = std::move(track);
+    _isModified = true;
+}
+
+bool LipTable::load(const std::string &path)
+{
+    std::ifstream input(path, std::ios::binary | std::ios::ate);
+    if (!input.is_open())
+        return false;
+
+    // the sizes read from the file are checked against the bytes left before allocating anything
+    auto fileSize = static_cast<uint64_t>(input.tellg());
+    input.seekg(0);
+    auto getRemaining = [&input, fileSize]() {
+        auto pos = input.tellg();
+        return pos < 0 ? 0 : fileSize - static_cast<uint64_t>(pos);
+    };
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t count = 0;
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char *>(&version), sizeof(version));
+    input.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!input || !std::equal(magic, magic + 4, LipTableMagic))
+    {
+        std::cerr << "Invalid lip table " << path << std::endl;
+        return false;
+    }
+    if (version != LipTableVersion)
+    {
+        std::cerr << "Lip table " << path << " has version " << version << " instead of " << LipTableVersion
+                  << ", it will be rebuilt" << std::endl;
+        return false;
+    }
+
+    std::map<std::string, std::shared_ptr<const NGLipTrack>> tracks;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t nameSize = 0;
+        input.read(reinterpret_cast<char *>(&nameSize), sizeof(nameSize));
+        if (!input || nameSize > getRemaining())
+        {
+            std::cerr << "Invalid lip table " << path << ": name size " << nameSize << " out of bounds" << std::endl;
+            return false;
+        }
+        std::string name(nameSize, '\0');
+        input.read(name.data(), nameSize);
+        uint32_t size = 0;
+        input.read(reinterpret_cast<char *>(&size), sizeof(size));
+        if (!input || size * LipDataSize > getRemaining())
+        {
+            std::cerr << "Invalid lip table " << path << ": track size " << size << " out of bounds" << std::endl;
+            return false;
+        }
+
+        auto track = std::make_shared<NGLipTrack>(size);
+        for (auto &data : *track)
+        {
+            float time = 0;
+            input.read(reinterpret_cast<char *>(&time), sizeof(time));
+            input.read(&data.letter, 1);
+            data.time = sf::seconds(time);
+        }
+        tracks[name] = track;
+    }
+    if (!input)
+    {
+        std::cerr << "Invalid lip table " << path << std::endl;
+        return false;
+    }
+    _tracks.insert(tracks.begin(), tracks.end());
+    return true;
+}
+
+bool LipTable::save(const std::string &path) const
+{
+    std::ofstream output(path, std::ios::binary);
+    if (!output.is_open())
+    {
+        std::cerr << "Unable to write lip table " << path << std::endl;
+        return false;
+    }
+
+    auto count = static_cast<uint32_t>(_tracks.size());
+    output.write(LipTableMagic, sizeof(LipTableMagic));
+    output.write(reinterpret_cast<const char *>(&LipTableVersion), sizeof(LipTableVersion));
+    output.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (const auto &entry : _tracks)
+    {
+        auto nameSize = static_cast<uint32_t>(entry.first.size());
+        output.write(reinterpret_cast<const char *>(&nameSize), sizeof(nameSize));
+        output.write(entry.first.data(), nameSize);
+        auto size = static_cast<uint32_t>(entry.second->size());
+        output.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        for (const auto &data : *entry.second)
+        {
+            auto time = data.time.asSeconds();
+            output.write(reinterpret_cast<const char *>(&time), sizeof(time));
+            output.write(&data.letter, 1);
+        }
+    }
+    return static_cast<bool>(output);
+}
+
 Lip::Lip()
-    : _pSettings(nullptr)
+    : _pSettings(nullptr), _pTable(nullptr), _data(std::make_shared<NGLipTrack>())
 {
 }
 
@@ -18,27 +192,26 @@ void Lip::setSettings(EngineSettings &settings)
 
 void Lip::load(const std::string &path)
 {
+    _path = path;
+    if (_pTable)
+    {
+        auto track = _pTable->get(path);
+        if (track)
+        {
+            _data = track;
+            return;
+        }
+    }
+
     if (!_pSettings)
         return;
 
     std::vector<char> buffer;
     _pSettings->readEntry(path, buffer);
-    GGPackBufferStream input(buffer);
-    _data.clear();
-    _path = path;
-    std::regex re(R"(^(\d*\.?\d*)\s+(\w)$)");
-
-    std::string line;
-    while (getLine(input, line))
+    _data = _parseLip(buffer);
+    if (_pTable)
     {
-        std::smatch matches;
-        if (!std::regex_search(line, matches, re))
-            continue;
-
-        auto t = std::strtof(matches[1].str().c_str(), nullptr);
-        auto text = matches[2].str();
-        NGLipData data{.time = sf::seconds(t), .letter = text[0]};
-        _data.emplace_back(data);
+        _pTable->add(path, _data);
     }
 }
 } // namespace ng
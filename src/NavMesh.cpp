@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+#include "NavMesh.h"
+#include "_IndexedPriorityQueue.h"
+#include "_NGUtil.h"
+
+namespace ng
+{
+// positive when c is on the left of the line from a to b
+static int64_t _cross(const sf::Vector2i &a, const sf::Vector2i &b, const sf::Vector2i &c)
+{
+    return static_cast<int64_t>(b.x - a.x) * (c.y - a.y) - static_cast<int64_t>(b.y - a.y) * (c.x - a.x);
+}
+
+static bool _insideTriangle(const sf::Vector2i &p, const sf::Vector2i &a, const sf::Vector2i &b, const sf::Vector2i &c)
+{
+    return _cross(a, b, p) >= 0 && _cross(b, c, p) >= 0 && _cross(c, a, p) >= 0;
+}
+
+static float _distance(const sf::Vector2f &v1, const sf::Vector2f &v2)
+{
+    auto delta = v2 - v1;
+    return std::sqrt(delta.x * delta.x + delta.y * delta.y);
+}
+
+static bool _isOnSegment(const sf::Vector2i &p, const sf::Vector2i &a, const sf::Vector2i &b)
+{
+    return p != a && p != b && _cross(a, b, p) == 0 && std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) &&
+           std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+}
+
+// Adds to the edges of each polygon the vertices of the other polygons lying on them.
+// Two walkboxes which are not merged can touch along edges which only overlap partly, a T-junction,
+// once split the triangles of both sides have the same edges and can be linked.
+static void _splitEdges(std::vector<std::vector<sf::Vector2i>> &polygons)
+{
+    std::vector<std::vector<sf::Vector2i>> result(polygons.size());
+    std::vector<sf::Vector2i> splits;
+    for (size_t i = 0; i < polygons.size(); i++)
+    {
+        const auto &polygon = polygons[i];
+        for (size_t j = 0; j < polygon.size(); j++)
+        {
+            const auto &v1 = polygon[j];
+            const auto &v2 = polygon[(j + 1) % polygon.size()];
+            splits.clear();
+            for (size_t k = 0; k < polygons.size(); k++)
+            {
+                if (k == i)
+                    continue;
+                for (const auto &vertex : polygons[k])
+                {
+                    if (_isOnSegment(vertex, v1, v2) && std::find(splits.begin(), splits.end(), vertex) == splits.end())
+                        splits.push_back(vertex);
+                }
+            }
+            std::sort(splits.begin(), splits.end(), [&v1](const sf::Vector2i &s1, const sf::Vector2i &s2) {
+                return std::abs(s1.x - v1.x) + std::abs(s1.y - v1.y) < std::abs(s2.x - v1.x) + std::abs(s2.y - v1.y);
+            });
+            result[i].push_back(v1);
+            result[i].insert(result[i].end(), splits.begin(), splits.end());
+        }
+    }
+    polygons = std::move(result);
+}
+
+NavMesh::NavMesh(const std::vector<Walkbox> &walkboxes)
+{
+    std::vector<std::vector<sf::Vector2i>> polygons;
+    for (const auto &walkbox : walkboxes)
+    {
+        if (!walkbox.isEnabled())
+            continue;
+        polygons.push_back(walkbox.getVertices());
+    }
+    _splitEdges(polygons);
+
+    // an aligned vertex shared with another walkbox is kept, it ends an edge of the triangles on the other side
+    std::unordered_map<sf::Vector2i, int, _VertexHash> owners;
+    for (const auto &polygon : polygons)
+    {
+        for (const auto &vertex : polygon)
+        {
+            owners[vertex]++;
+        }
+    }
+    for (auto &polygon : polygons)
+    {
+        std::vector<bool> isShared;
+        for (const auto &vertex : polygon)
+        {
+            isShared.push_back(owners[vertex] > 1);
+        }
+        triangulate(std::move(polygon), std::move(isShared));
+    }
+    linkTriangles();
+}
+
+void NavMesh::addTriangle(const sf::Vector2i &v1, const sf::Vector2i &v2, const sf::Vector2i &v3)
+{
+    Triangle triangle;
+    triangle.vertices = {v1, v2, v3};
+    triangle.centroid = sf::Vector2f(v1 + v2 + v3) / 3.f;
+    _triangles.push_back(triangle);
+}
+
+// ear clipping, the polygons are small enough for the quadratic search of the ears
+void NavMesh::triangulate(std::vector<sf::Vector2i> polygon, std::vector<bool> isShared)
+{
+    // the repeated vertices and the aligned ones which are not shared with another walkbox would give flat triangles
+    for (size_t i = 0; polygon.size() >= 3 && i < polygon.size();)
+    {
+        const auto &previous = polygon[(i + polygon.size() - 1) % polygon.size()];
+        const auto &next = polygon[(i + 1) % polygon.size()];
+        if (polygon[i] == next || (_cross(previous, polygon[i], next) == 0 && !isShared[i]))
+        {
+            polygon.erase(polygon.begin() + i);
+            isShared.erase(isShared.begin() + i);
+            i = i > 0 ? i - 1 : 0;
+            continue;
+        }
+        i++;
+    }
+    if (polygon.size() < 3)
+        return;
+
+    int64_t area = 0;
+    for (size_t i = 0; i < polygon.size(); i++)
+    {
+        const auto &v1 = polygon[i];
+        const auto &v2 = polygon[(i + 1) % polygon.size()];
+        area += static_cast<int64_t>(v1.x) * v2.y - static_cast<int64_t>(v2.x) * v1.y;
+    }
+    if (area < 0)
+    {
+        std::reverse(polygon.begin(), polygon.end());
+    }
+
+    size_t i = 0;
+    size_t tries = 0;
+    while (polygon.size() > 3)
+    {
+        if (tries == polygon.size())
+        {
+            std::cerr << "Unable to triangulate a walkbox, " << polygon.size() << " vertices left" << std::endl;
+            return;
+        }
+
+        i %= polygon.size();
+        const auto &previous = polygon[(i + polygon.size() - 1) % polygon.size()];
+        const auto &current = polygon[i];
+        const auto &next = polygon[(i + 1) % polygon.size()];
+        auto isEar = _cross(previous, current, next) > 0;
+        for (size_t j = 0; isEar && j < polygon.size(); j++)
+        {
+            const auto &vertex = polygon[j];
+            if (vertex == previous || vertex == current || vertex == next)
+                continue;
+            isEar = !_insideTriangle(vertex, previous, current, next);
+        }
+        if (!isEar)
+        {
+            i++;
+            tries++;
+            continue;
+        }
+
+        addTriangle(previous, current, next);
+        polygon.erase(polygon.begin() + i);
+        // the next ear is often close to the last one
+        i = i > 0 ? i - 1 : 0;
+        tries = 0;
+    }
+    if (polygon.size() == 3)
+    {
+        addTriangle(polygon[0], polygon[1], polygon[2]);
+    }
+}
+
+void NavMesh::linkTriangles()
+{
+    std::unordered_map<_EdgeKey, std::pair<int, int>, _EdgeKeyHash> edges;
+    for (size_t i = 0; i < _triangles.size(); i++)
+    {
+        auto &triangle = _triangles[i];
+        for (int j = 0; j < 3; j++)
+        {
+            const auto &v1 = triangle.vertices[j];
+            const auto &v2 = triangle.vertices[(j + 1) % 3];
+            // the neighbour has the same edge in the other direction
+            auto it = edges.find({v2, v1});
+            if (it != edges.end())
+            {
+                triangle.neighbours[j] = it->second.first;
+                _triangles[it->second.first].neighbours[it->second.second] = static_cast<int>(i);
+                edges.erase(it);
+                continue;
+            }
+            edges.insert({{v1, v2}, {static_cast<int>(i), j}});
+        }
+    }
+}
+
+int NavMesh::locate(const sf::Vector2i &position) const
+{
+    for (size_t i = 0; i < _triangles.size(); i++)
+    {
+        const auto &vertices = _triangles[i].vertices;
+        if (_insideTriangle(position, vertices[0], vertices[1], vertices[2]))
+            return static_cast<int>(i);
+    }
+
+    // the positions snapped to the walkboxes can be slightly outside after rounding
+    auto closest = -1;
+    auto minDistance = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < _triangles.size(); i++)
+    {
+        const auto &vertices = _triangles[i].vertices;
+        for (int j = 0; j < 3; j++)
+        {
+            auto distance = Walkbox::distanceToSegment(position, vertices[j], vertices[(j + 1) % 3]);
+            if (distance < minDistance)
+            {
+                minDistance = distance;
+                closest = static_cast<int>(i);
+            }
+        }
+    }
+    return closest;
+}
+
+bool NavMesh::findCorridor(int start, int end, const sf::Vector2i &to)
+{
+    auto target = sf::Vector2f(to);
+    _gCosts.assign(_triangles.size(), std::numeric_limits<float>::infinity());
+    _fCosts.assign(_triangles.size(), 0);
+    _parents.assign(_triangles.size(), -1);
+    _gCosts[start] = 0;
+    _fCosts[start] = _distance(_triangles[start].centroid, target);
+
+    _IndexedPriorityQueue pq(_fCosts, _queue, _queuePositions);
+    pq.insert(start);
+    auto found = false;
+    while (!pq.isEmpty())
+    {
+        auto index = pq.pop();
+        if (index == end)
+        {
+            found = true;
+            break;
+        }
+        const auto &triangle = _triangles[index];
+        for (auto neighbour : triangle.neighbours)
+        {
+            if (neighbour < 0)
+                continue;
+            auto cost = _gCosts[index] + _distance(triangle.centroid, _triangles[neighbour].centroid);
+            if (cost >= _gCosts[neighbour])
+                continue;
+            _gCosts[neighbour] = cost;
+            _fCosts[neighbour] = cost + _distance(_triangles[neighbour].centroid, target);
+            _parents[neighbour] = index;
+            if (_queuePositions[neighbour] >= 0)
+                pq.decrease(neighbour);
+            else
+                pq.insert(neighbour);
+        }
+    }
+    if (!found)
+        return false;
+
+    _corridor.clear();
+    for (auto index = end; index != -1; index = _parents[index])
+    {
+        _corridor.push_back(index);
+    }
+    std::reverse(_corridor.begin(), _corridor.end());
+    return true;
+}
+
+void NavMesh::trimCorridor(const sf::Vector2i &from, const sf::Vector2i &to)
+{
+    auto contains = [this](int index, const sf::Vector2i &position) {
+        const auto &vertices = _triangles[index].vertices;
+        return _insideTriangle(position, vertices[0], vertices[1], vertices[2]);
+    };
+    // a position on an edge would start the funnel with a flat portal and give a false corner
+    size_t first = 0;
+    while (first + 1 < _corridor.size() && contains(_corridor[first + 1], from))
+        first++;
+    auto last = _corridor.size() - 1;
+    while (last > first && contains(_corridor[last - 1], to))
+        last--;
+    _corridor.erase(_corridor.begin() + last + 1, _corridor.end());
+    _corridor.erase(_corridor.begin(), _corridor.begin() + first);
+}
+
+// simple stupid funnel algorithm, see http://digestingduck.blogspot.com/2010/03/simple-stupid-funnel-algorithm.html
+void NavMesh::pullString(const sf::Vector2i &from, const sf::Vector2i &to, std::vector<sf::Vector2i> &path)
+{
+    _portals.clear();
+    _portals.emplace_back(from, from);
+    for (size_t i = 0; i + 1 < _corridor.size(); i++)
+    {
+        const auto &triangle = _triangles[_corridor[i]];
+        for (int j = 0; j < 3; j++)
+        {
+            if (triangle.neighbours[j] != _corridor[i + 1])
+                continue;
+            // the triangle is counterclockwise, so leaving it through an edge its end is on the left
+            _portals.emplace_back(triangle.vertices[(j + 1) % 3], triangle.vertices[j]);
+            break;
+        }
+    }
+    _portals.emplace_back(to, to);
+
+    // a portal adds one corner at most
+    path.reserve(_portals.size() + 1);
+    path.push_back(from);
+    auto apex = from;
+    auto left = from;
+    auto right = from;
+    size_t apexIndex = 0;
+    size_t leftIndex = 0;
+    size_t rightIndex = 0;
+    for (size_t i = 1; i < _portals.size(); i++)
+    {
+        const auto &portalLeft = _portals[i].first;
+        const auto &portalRight = _portals[i].second;
+
+        // tighten the right side of the funnel
+        if (_cross(apex, right, portalRight) >= 0)
+        {
+            if (apex == right || _cross(apex, left, portalRight) < 0)
+            {
+                right = portalRight;
+                rightIndex = i;
+            }
+            else
+            {
+                // the right side crosses the left one, the left vertex is a corner of the path
+                if (path.back() != left)
+                    path.push_back(left);
+                apex = left;
+                apexIndex = leftIndex;
+                right = apex;
+                rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+
+        // tighten the left side of the funnel
+        if (_cross(apex, left, portalLeft) <= 0)
+        {
+            if (apex == left || _cross(apex, right, portalLeft) > 0)
+            {
+                left = portalLeft;
+                leftIndex = i;
+            }
+            else
+            {
+                if (path.back() != right)
+                    path.push_back(right);
+                apex = right;
+                apexIndex = rightIndex;
+                left = apex;
+                leftIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+    }
+    if (path.back() != to)
+        path.push_back(to);
+}
+
+void NavMesh::calculatePath(const sf::Vector2i &from, const sf::Vector2i &to, std::vector<sf::Vector2i> &path)
+{
+    path.clear();
+    auto start = locate(from);
+    auto end = locate(to);
+    // like the visibility graph, only the end is returned when it can't be reached
+    if (start < 0 || end < 0 || !findCorridor(start, end, to))
+    {
+        path.push_back(to);
+        return;
+    }
+    trimCorridor(from, to);
+    pullString(from, to, path);
+}
+} // namespace ng
@@ -8,7 +8,7 @@ namespace ng
 struct Object::Impl
 {
     std::vector<std::unique_ptr<Animation>> _anims;
-    std::optional<Animation> _pAnim;
+    Animation *_pAnim;
     std::wstring _name, _id;
     int _zorder;
     UseDirection _direction;
@@ -32,7 +32,7 @@ struct Object::Impl
     int dependentState{0};
 
     Impl()
-        : _pAnim(std::nullopt),
+        : _pAnim(nullptr),
           _zorder(0),
           _direction(UseDirection::Front),
           _prop(false),
@@ -185,21 +185,28 @@ int Object::getState()
 
 void Object::setAnimation(const std::string &name)
 {
+    // only the current animation is playing, the track of the previous one would keep running its triggers
+    if (pImpl->_pAnim)
+    {
+        pImpl->_pAnim->pause();
+    }
+
     auto it = std::find_if(pImpl->_anims.begin(), pImpl->_anims.end(), [name](std::unique_ptr<Animation> &animation) { return animation->getName() == name; });
     if (it == pImpl->_anims.end())
     {
-        pImpl->_pAnim = std::nullopt;
+        pImpl->_pAnim = nullptr;
         return;
     }
 
-    auto &anim = *(it->get());
-    pImpl->_pAnim = anim;
+    pImpl->_pAnim = it->get();
+    pImpl->_pAnim->pause();
+    pImpl->_pAnim->reset();
     pImpl->_pAnim->setObject(this);
     auto &sprite = pImpl->_pAnim->getSprite();
     sprite.setColor(pImpl->_color);
 }
 
-std::optional<Animation> &Object::getAnimation()
+Animation *Object::getAnimation()
 {
     return pImpl->_pAnim;
 }
@@ -246,10 +253,6 @@ void Object::update(const sf::Time &elapsed)
             setTouchable(false);
         }
     }
-    if (pImpl->_pAnim)
-    {
-        pImpl->_pAnim->update(elapsed);
-    }
     if (pImpl->_triggerEnabled)
     {
         for (auto &trigger : pImpl->_triggers)
@@ -305,7 +308,7 @@ void Object::dependentOn(Object *parentObject, int state)
 
 void Object::setFps(int fps)
 {
-    if (pImpl->_pAnim.has_value())
+    if (pImpl->_pAnim)
     {
         pImpl->_pAnim->setFps(fps);
     }
@@ -1,177 +1,485 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <unordered_set>
 #include <utility>
 #include <math.h>
 #include <sstream>
 #include "PathFinder.h"
+#include "_IndexedPriorityQueue.h"
 #include "_NGUtil.h"
 
 namespace ng
 {
-class _IndexedPriorityQueue
+// Start and end nodes of a query linked to the base graph, the base graph is never copied.
+// The buffers are kept between the queries so a query doesn't allocate once they have grown.
+struct PathFinder::Query
 {
-    std::vector<float> &_keys;
-    std::vector<int> _data;
-
-  public:
-    explicit _IndexedPriorityQueue(std::vector<float> &keys)
-        : _keys(keys)
+    const Graph *pGraph{nullptr};
+    int start{0};
+    int end{0};
+    sf::Vector2i startNode;
+    sf::Vector2i endNode;
+    // edges from the start node
+    std::vector<GraphEdge> startEdges;
+    // cost of the edge from each node of the base graph to the end node, negative when there is no edge
+    std::vector<float> endCosts;
+    // A* state
+    std::vector<float> gCosts;
+    std::vector<float> fCosts;
+    std::vector<int> frontier;
+    std::vector<int> tree;
+    std::vector<int> queue;
+    std::vector<int> queuePositions;
+
+    void reset(const Graph &graph)
     {
+        pGraph = &graph;
+        auto size = graph.nodes.size();
+        start = static_cast<int>(size);
+        end = start + 1;
+        startEdges.clear();
+        endCosts.assign(size, -1.f);
     }
 
-    void insert(int index)
-    {
-        _data.push_back(index);
-        reorderUp();
-    }
+    size_t size() const { return pGraph->nodes.size() + 2; }
 
-    int pop()
+    const sf::Vector2i &getNode(int index) const
     {
-        int r = _data[0];
-        _data[0] = _data[_data.size() - 1];
-        _data.pop_back();
-        reorderDown();
-        return r;
+        if (index == start)
+            return startNode;
+        if (index == end)
+            return endNode;
+        return pGraph->nodes[index];
     }
 
-    void reorderUp()
+    template <typename F>
+    void forEachEdge(int node, F f) const
     {
-        if (_data.empty())
-            return;
-        size_t a = _data.size() - 1;
-        while (a > 0)
+        if (node == start)
         {
-            if (_keys[_data[a]] >= _keys[_data[a - 1]])
-                return;
-            int tmp = _data[a];
-            _data[a] = _data[a - 1];
-            _data[a - 1] = tmp;
-            a--;
+            for (const auto &edge : startEdges)
+            {
+                f(edge.to, edge.cost);
+            }
+            return;
         }
-    }
-
-    void reorderDown()
-    {
-        if (_data.empty())
+        if (node == end)
             return;
-        for (int a = 0; a < _data.size() - 1; a++)
+        for (auto it = pGraph->beginEdges(node); it != pGraph->endEdges(node); ++it)
         {
-            if (_keys[_data[a]] <= _keys[_data[a + 1]])
-                return;
-            int tmp = _data[a];
-            _data[a] = _data[a + 1];
-            _data[a + 1] = tmp;
+            f(static_cast<int>(it->to), it->cost);
+        }
+        if (endCosts[node] >= 0)
+        {
+            f(end, endCosts[node]);
         }
-    }
-
-    bool isEmpty()
-    {
-        return _data.empty();
     }
 };
+
 class _AstarAlgorithm
 {
   private:
-    Graph &_graph;
-    std::vector<std::shared_ptr<GraphEdge>> SPT;
-    std::vector<float> G_Cost; //This array will store the G cost of each node
-    std::vector<float> F_Cost; //This array will store the F cost of each node
-    std::vector<std::shared_ptr<GraphEdge>> SF;
+    PathFinder::Query &_query;
     int _source;
     int _target;
 
   public:
-    _AstarAlgorithm(Graph &graph, int source, int target)
-        : _graph(graph), _source(source), _target(target)
+    _AstarAlgorithm(PathFinder::Query &query, int source, int target)
+        : _query(query), _source(source), _target(target)
     {
-        G_Cost.resize(_graph.nodes.size(), 0);
-        F_Cost.resize(_graph.nodes.size(), 0);
-        SPT.resize(_graph.nodes.size(), nullptr);
-        SF.resize(_graph.nodes.size(), nullptr);
+        auto size = _query.size();
+        _query.gCosts.assign(size, 0);
+        _query.fCosts.assign(size, 0);
+        _query.tree.assign(size, -1);
+        _query.frontier.assign(size, -1);
         search();
     }
 
-    std::vector<int> getPath() const
+    void getPath(std::vector<sf::Vector2i> &path) const
     {
-        std::vector<int> path;
+        path.clear();
         if (_target < 0)
-            return path;
+            return;
+        size_t size = 1;
+        for (int nd = _target; (nd != _source) && (_query.tree[nd] != -1); nd = _query.tree[nd])
+        {
+            size++;
+        }
+        path.resize(size);
         int nd = _target;
-        path.push_back(nd);
-        while ((nd != _source) && (SPT[nd] != nullptr))
+        path[--size] = _query.getNode(nd);
+        while ((nd != _source) && (_query.tree[nd] != -1))
         {
-            nd = SPT[nd]->from;
-            path.push_back(nd);
+            nd = _query.tree[nd];
+            path[--size] = _query.getNode(nd);
         }
-        std::reverse(path.begin(), path.end());
-        return path;
     }
 
   private:
     void search()
     {
-        _IndexedPriorityQueue pq(F_Cost);
+        auto &gCosts = _query.gCosts;
+        auto &fCosts = _query.fCosts;
+        auto &frontier = _query.frontier;
+        auto &tree = _query.tree;
+        _IndexedPriorityQueue pq(fCosts, _query.queue, _query.queuePositions);
         pq.insert(_source);
         while (!pq.isEmpty())
         {
             int NCN = pq.pop();
-            SPT[NCN] = SF[NCN];
+            tree[NCN] = frontier[NCN];
             if (NCN == _target)
                 return;
-            auto &edges = _graph.edges[NCN];
-            for (auto &edge : edges)
+            _query.forEachEdge(NCN, [&](int to, float cost) {
+                float Hcost = length(_query.getNode(to) - _query.getNode(_target));
+                float Gcost = gCosts[NCN] + cost;
+                if (frontier[to] == -1)
+                {
+                    fCosts[to] = Gcost + Hcost;
+                    gCosts[to] = Gcost;
+                    pq.insert(to);
+                    frontier[to] = NCN;
+                }
+                else if ((Gcost < gCosts[to]) && (tree[to] == -1))
+                {
+                    fCosts[to] = Gcost + Hcost;
+                    gCosts[to] = Gcost;
+                    pq.decrease(to);
+                    frontier[to] = NCN;
+                }
+            });
+        }
+    }
+};
+
+// Shortest paths between all the nodes of the base graph, found with a Dijkstra search from each node.
+struct PathFinder::ShortestPaths
+{
+    size_t size{0};
+    // cost of the shortest path from i to j at i * size + j, infinite when there is no path
+    std::vector<float> costs;
+    // node before j on the shortest path from i to j at i * size + j
+    std::vector<int> previous;
+
+    static std::unique_ptr<ShortestPaths> compute(const Graph &graph, const std::atomic<bool> &isCancelled)
+    {
+        const auto infinity = std::numeric_limits<float>::infinity();
+        auto paths = std::make_unique<ShortestPaths>();
+        auto size = graph.nodes.size();
+        paths->size = size;
+        paths->costs.resize(size * size);
+        paths->previous.assign(size * size, -1);
+
+        std::vector<float> costs(size);
+        std::vector<int> queue;
+        std::vector<int> positions;
+        for (size_t source = 0; source < size; source++)
+        {
+            if (isCancelled)
+                return nullptr;
+
+            auto *previous = paths->previous.data() + source * size;
+            std::fill(costs.begin(), costs.end(), infinity);
+            costs[source] = 0;
+            _IndexedPriorityQueue pq(costs, queue, positions);
+            pq.insert(static_cast<int>(source));
+            while (!pq.isEmpty())
             {
-                float Hcost = length(_graph.nodes[edge->to] - _graph.nodes[_target]);
-                float Gcost = G_Cost[NCN] + edge->cost;
-                if (SF[edge->to] == nullptr)
+                auto node = pq.pop();
+                for (auto it = graph.beginEdges(node); it != graph.endEdges(node); ++it)
                 {
-                    F_Cost[edge->to] = Gcost + Hcost;
-                    G_Cost[edge->to] = Gcost;
-                    pq.insert(edge->to);
-                    SF[edge->to] = edge;
+                    auto to = static_cast<int>(it->to);
+                    auto cost = costs[node] + it->cost;
+                    if (cost >= costs[to])
+                        continue;
+                    costs[to] = cost;
+                    previous[to] = node;
+                    if (positions[to] >= 0)
+                        pq.decrease(to);
+                    else
+                        pq.insert(to);
                 }
-                else if ((Gcost < G_Cost[edge->to]) && (SPT[edge->to] == nullptr))
+            }
+            std::copy(costs.begin(), costs.end(), paths->costs.begin() + source * size);
+        }
+        return paths;
+    }
+
+    // links the start and the end of the query through the best pair of nodes they can see
+    void getPath(const PathFinder::Query &query, std::vector<sf::Vector2i> &path) const
+    {
+        auto bestCost = std::numeric_limits<float>::infinity();
+        auto bestFirst = -1;
+        auto bestLast = -1;
+        for (const auto &edge : query.startEdges)
+        {
+            if (edge.to == query.end)
+            {
+                if (edge.cost < bestCost)
+                {
+                    bestCost = edge.cost;
+                    bestFirst = bestLast = -1;
+                }
+                continue;
+            }
+            const auto *pCosts = costs.data() + edge.to * size;
+            for (size_t last = 0; last < size; last++)
+            {
+                if (query.endCosts[last] < 0)
+                    continue;
+                auto cost = edge.cost + pCosts[last] + query.endCosts[last];
+                if (cost < bestCost)
                 {
-                    F_Cost[edge->to] = Gcost + Hcost;
-                    G_Cost[edge->to] = Gcost;
-                    pq.reorderUp();
-                    SF[edge->to] = edge;
+                    bestCost = cost;
+                    bestFirst = edge.to;
+                    bestLast = static_cast<int>(last);
                 }
             }
         }
+
+        // like the A* search, only the end is returned when it can't be reached
+        path.clear();
+        if (bestCost == std::numeric_limits<float>::infinity())
+        {
+            path.push_back(query.endNode);
+            return;
+        }
+        size_t count = 2;
+        const int *pPrevious = bestFirst >= 0 ? previous.data() + bestFirst * size : nullptr;
+        if (pPrevious)
+        {
+            count++;
+            for (auto node = bestLast; node != bestFirst; node = pPrevious[node])
+            {
+                count++;
+            }
+        }
+        path.resize(count);
+        path[0] = query.startNode;
+        path[--count] = query.endNode;
+        if (pPrevious)
+        {
+            for (auto node = bestLast; node != bestFirst; node = pPrevious[node])
+            {
+                path[--count] = query.getNode(node);
+            }
+            path[--count] = query.getNode(bestFirst);
+        }
     }
 };
 
-PathFinder::PathFinder(const std::vector<Walkbox> &walkboxes)
-    : _walkboxes(walkboxes)
+// Edges of the walkboxes which can block the line of sight, bucketed in a uniform grid.
+// An edge is stored in every cell overlapped by its bounding box, a segment only tests
+// the edges of the cells it goes through and each edge once.
+struct PathFinder::EdgeGrid
 {
-}
+    std::vector<std::pair<sf::Vector2i, sf::Vector2i>> edges;
+    sf::Vector2i origin;
+    sf::Vector2i size;
+    int cellSize{1};
+    std::vector<uint32_t> cellOffsets;
+    std::vector<uint32_t> cellEdges;
+    // the last query which has tested each edge
+    std::vector<uint32_t> stamps;
+    uint32_t stamp{0};
+
+    explicit EdgeGrid(const std::vector<Walkbox> &walkboxes)
+    {
+        // an edge shared by two walkboxes is walkable, so it's not an obstacle
+        std::unordered_set<_EdgeKey, _EdgeKeyHash> directedEdges;
+        for (const auto &walkbox : walkboxes)
+        {
+            forEachWalkboxEdge(walkbox, [&directedEdges](const sf::Vector2i &v1, const sf::Vector2i &v2) {
+                directedEdges.insert({v1, v2});
+            });
+        }
 
-std::vector<std::pair<sf::Vector2i, sf::Vector2i>> _sharedLines;
+        sf::Vector2i min(std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
+        sf::Vector2i max(std::numeric_limits<int>::min(), std::numeric_limits<int>::min());
+        for (const auto &walkbox : walkboxes)
+        {
+            forEachWalkboxEdge(walkbox, [&](const sf::Vector2i &v1, const sf::Vector2i &v2) {
+                if (directedEdges.find({v2, v1}) != directedEdges.end())
+                    return;
+                edges.emplace_back(v1, v2);
+                min.x = std::min(min.x, std::min(v1.x, v2.x));
+                min.y = std::min(min.y, std::min(v1.y, v2.y));
+                max.x = std::max(max.x, std::max(v1.x, v2.x));
+                max.y = std::max(max.y, std::max(v1.y, v2.y));
+            });
+        }
+        stamps.assign(edges.size(), 0);
+        if (edges.empty())
+        {
+            size = sf::Vector2i(1, 1);
+            cellOffsets.assign(2, 0);
+            return;
+        }
 
-std::shared_ptr<Graph> PathFinder::createGraph()
-{
-    _sharedLines.clear();
+        // about one edge per cell
+        auto area = static_cast<float>(max.x - min.x + 1) * static_cast<float>(max.y - min.y + 1);
+        cellSize = std::max(8, static_cast<int>(std::ceil(std::sqrt(area / edges.size()))));
+        origin = min;
+        size.x = (max.x - min.x) / cellSize + 1;
+        size.y = (max.y - min.y) / cellSize + 1;
+
+        // counting sort of the edges by cell
+        cellOffsets.assign(size.x * size.y + 1, 0);
+        for (const auto &edge : edges)
+        {
+            forEachCell(edge.first, edge.second, [this](int cell) {
+                cellOffsets[cell + 1]++;
+                return false;
+            });
+        }
+        for (size_t i = 1; i < cellOffsets.size(); i++)
+        {
+            cellOffsets[i] += cellOffsets[i - 1];
+        }
+        cellEdges.resize(cellOffsets.back());
+        auto next = cellOffsets;
+        for (uint32_t i = 0; i < edges.size(); i++)
+        {
+            forEachCell(edges[i].first, edges[i].second, [&](int cell) {
+                cellEdges[next[cell]++] = i;
+                return false;
+            });
+        }
+    }
 
-    for (const auto & w1 : _walkboxes)
+    int getCellX(float x) const
     {
-        for (const auto & w2 : _walkboxes)
+        auto cell = static_cast<int>(std::floor((x - origin.x) / cellSize));
+        return std::clamp(cell, 0, size.x - 1);
+    }
+
+    int getCellY(float y) const
+    {
+        auto cell = static_cast<int>(std::floor((y - origin.y) / cellSize));
+        return std::clamp(cell, 0, size.y - 1);
+    }
+
+    // calls f for each cell overlapped by the segment, with a margin of one unit, until f returns true
+    template <typename F>
+    bool forEachCell(const sf::Vector2i &start, const sf::Vector2i &end, F f) const
+    {
+        const float margin = 1.f;
+        auto minX = std::min(start.x, end.x) - margin;
+        auto maxX = std::max(start.x, end.x) + margin;
+        auto dx = static_cast<float>(end.x - start.x);
+        auto dy = static_cast<float>(end.y - start.y);
+        auto lastX = getCellX(maxX);
+        for (auto x = getCellX(minX); x <= lastX; x++)
         {
-            for (auto i = 0; i < w1.getVertices().size(); i++)
+            // vertical extent of the segment in this column
+            auto x1 = std::max(minX, static_cast<float>(origin.x + x * cellSize));
+            auto x2 = std::min(maxX, static_cast<float>(origin.x + (x + 1) * cellSize));
+            float y1 = start.y;
+            float y2 = end.y;
+            if (dx != 0)
             {
-                auto v1 = w1.getVertex(i);
-                auto v1p = w2.getVertex((i + 1) % w1.getVertices().size());
-                if (v1 == v1p)
-                {
-                    auto v2 = w1.getVertex((i + 1) % w1.getVertices().size());
-                    auto v2p = w2.getVertex(i);
-                    if (v2 == v2p)
-                    {
-                        _sharedLines.emplace_back(v1, v2);
-                    }
-                }
+                y1 = start.y + (x1 - start.x) * dy / dx;
+                y2 = start.y + (x2 - start.x) * dy / dx;
+            }
+            auto lastY = getCellY(std::max(y1, y2) + margin);
+            for (auto y = getCellY(std::min(y1, y2) - margin); y <= lastY; y++)
+            {
+                if (f(y * size.x + x))
+                    return true;
             }
         }
+        return false;
     }
 
+    // calls f for each edge which can intersect the segment until f returns true
+    template <typename F>
+    bool any(const sf::Vector2i &start, const sf::Vector2i &end, F f)
+    {
+        if (++stamp == 0)
+        {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            stamp = 1;
+        }
+        return forEachCell(start, end, [&](int cell) {
+            for (auto i = cellOffsets[cell]; i < cellOffsets[cell + 1]; i++)
+            {
+                auto index = cellEdges[i];
+                if (stamps[index] == stamp)
+                    continue;
+                stamps[index] = stamp;
+                if (f(edges[index].first, edges[index].second))
+                    return true;
+            }
+            return false;
+        });
+    }
+};
+
+PathFinder::PathFinder(std::vector<Walkbox> walkboxes, PathFinderMode mode)
+    : _walkboxes(std::move(walkboxes)), _mode(mode), _query(std::make_unique<Query>()), _edgeGrid(std::make_unique<EdgeGrid>(_walkboxes))
+{
+    _walkboxGrid.build(_walkboxes);
+}
+
+PathFinder::~PathFinder()
+{
+    _isCancelled = true;
+    if (_pendingPaths.valid())
+    {
+        _pendingPaths.wait();
+    }
+}
+
+std::shared_ptr<Graph> PathFinder::getGraph() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _graph;
+}
+
+void PathFinder::precomputePaths()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_mode == PathFinderMode::NavMesh)
+    {
+        if (!_navMesh)
+        {
+            _navMesh = std::make_unique<NavMesh>(_walkboxes);
+        }
+        return;
+    }
+    if (!_graph)
+    {
+        _graph = createGraph();
+    }
+    if (_paths || _pendingPaths.valid() || _graph->nodes.size() > MaxPrecomputedNodes)
+        return;
+
+    // the graph is frozen so the worker can read it while the queries use A*
+    auto graph = _graph;
+    _pendingPaths = std::async(std::launch::async, [graph, this]() { return ShortestPaths::compute(*graph, _isCancelled); });
+}
+
+bool PathFinder::hasPrecomputedPaths()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_mode == PathFinderMode::NavMesh)
+        return _navMesh != nullptr;
+    return updatePrecomputedPaths();
+}
+
+bool PathFinder::updatePrecomputedPaths()
+{
+    if (_pendingPaths.valid() && _pendingPaths.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        _paths = _pendingPaths.get();
+    }
+    return _paths != nullptr;
+}
+
+std::shared_ptr<Graph> PathFinder::createGraph()
+{
     auto mainwalkgraph = std::make_shared<Graph>();
     for (const auto &walkbox : _walkboxes)
     {
@@ -188,18 +496,27 @@ std::shared_ptr<Graph> PathFinder::createGraph()
             mainwalkgraph->addNode(vertex);
         }
     }
+    // a vertex of a disabled walkbox can be outside of the walkable area
+    _walkableVertices.clear();
+    for (const auto &vertex : mainwalkgraph->concaveVertices)
+    {
+        _walkableVertices.push_back(isWalkable(vertex));
+    }
     for (auto i = 0; i < mainwalkgraph->concaveVertices.size(); i++)
     {
+        if (!_walkableVertices[i])
+            continue;
         for (auto j = 0; j < mainwalkgraph->concaveVertices.size(); j++)
         {
             auto &c1 = mainwalkgraph->concaveVertices[i];
             auto &c2 = mainwalkgraph->concaveVertices[j];
-            if (inLineOfSight(c1, c2))
+            if (_walkableVertices[j] && isSegmentClear(c1, c2))
             {
-                mainwalkgraph->addEdge(std::make_shared<GraphEdge>(i, j, distance(c1, c2)));
+                mainwalkgraph->addEdge(GraphEdge(i, j, distance(c1, c2)));
             }
         }
     }
+    mainwalkgraph->freeze();
     return mainwalkgraph;
 }
 
@@ -220,100 +537,86 @@ sf::Vector2i PathFinder::getClosestPointOnEdge(const sf::Vector2i &from) const
     return closestPoint;
 }
 
-bool _isShared(sf::Vector2i v1, sf::Vector2i v2)
+std::vector<sf::Vector2i> PathFinder::calculatePath(sf::Vector2i from, sf::Vector2i to)
 {
-    for (auto line : _sharedLines)
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!isWalkable(from))
     {
-        if (line.first == v1 && line.second == v2)
-        {
-            return true;
-        }
-        if (line.first == v2 && line.second == v1)
+        from = getClosestPointOnEdge(from);
+    }
+    if (!isWalkable(to))
+    {
+        to = getClosestPointOnEdge(to);
+    }
+
+    std::vector<sf::Vector2i> path;
+    if (_mode == PathFinderMode::NavMesh)
+    {
+        if (!_navMesh)
         {
-            return true;
+            _navMesh = std::make_unique<NavMesh>(_walkboxes);
         }
+        _navMesh->calculatePath(from, to, path);
+        return path;
     }
-    return false;
-}
 
-std::vector<sf::Vector2i> PathFinder::calculatePath(sf::Vector2i from, sf::Vector2i to)
-{
     if (!_graph)
     {
         _graph = createGraph();
     }
 
-    Graph walkgraph(*_graph);
-    //create new node on start position
-    auto startNodeIndex = static_cast<int>(walkgraph.nodes.size());
-    auto it = std::find_if(std::begin(_walkboxes), std::end(_walkboxes), [from](const Walkbox &b) { return b.isEnabled() && b.inside(from); });
-    if (it == std::end(_walkboxes))
-    {
-        from = getClosestPointOnEdge(from);
-    }
-    it = std::find_if(std::begin(_walkboxes), std::end(_walkboxes), [to](const Walkbox &b) { return b.isEnabled() && b.inside(to); });
-    if (it == std::end(_walkboxes))
-    {
-        to = getClosestPointOnEdge(to);
-    }
+    auto &query = *_query;
+    query.reset(*_graph);
 
-    walkgraph.addNode(from);
+    auto isFromWalkable = isWalkable(from);
+    auto isToWalkable = isWalkable(to);
 
-    for (auto i = 0; i < walkgraph.concaveVertices.size(); i++)
+    //create new node on start position
+    query.startNode = from;
+    for (auto i = 0; isFromWalkable && i < _graph->concaveVertices.size(); i++)
     {
-        auto c = walkgraph.concaveVertices[i];
-        if (inLineOfSight(from, c))
+        auto c = _graph->concaveVertices[i];
+        if (_walkableVertices[i] && isSegmentClear(from, c))
         {
-            walkgraph.addEdge(std::make_shared<GraphEdge>(startNodeIndex, i, distance(from, c)));
+            query.startEdges.emplace_back(query.start, i, distance(from, c));
         }
     }
 
     //create new node on end position
-    int endNodeIndex = static_cast<int>(walkgraph.nodes.size());
-    walkgraph.addNode(to);
-
-    for (auto i = 0; i < walkgraph.concaveVertices.size(); i++)
+    query.endNode = to;
+    for (auto i = 0; isToWalkable && i < _graph->concaveVertices.size(); i++)
     {
-        auto c = walkgraph.concaveVertices[i];
-        if (inLineOfSight(to, c))
+        auto c = _graph->concaveVertices[i];
+        if (_walkableVertices[i] && isSegmentClear(to, c))
         {
-            auto edge = std::make_shared<GraphEdge>(i, endNodeIndex, distance(to, c));
-            walkgraph.addEdge(edge);
+            query.endCosts[i] = distance(to, c);
         }
     }
-    if (inLineOfSight(from, to))
+    if (isFromWalkable && isToWalkable && isSegmentClear(from, to))
     {
-        auto edge = std::make_shared<GraphEdge>(startNodeIndex, endNodeIndex, distance(from, to));
-        walkgraph.addEdge(edge);
+        query.startEdges.emplace_back(query.start, query.end, distance(from, to));
     }
 
-    _AstarAlgorithm astar(walkgraph, startNodeIndex, endNodeIndex);
-    auto indices = astar.getPath();
-    std::vector<sf::Vector2i> path;
-    path.reserve(indices.size());
-    for (auto i : indices)
+    if (updatePrecomputedPaths())
     {
-        path.push_back(walkgraph.nodes[i]);
+        _paths->getPath(query, path);
+        return path;
     }
+
+    _AstarAlgorithm astar(query, query.start, query.end);
+    astar.getPath(path);
     return path;
 }
 
-bool PathFinder::inLineOfSight(const sf::Vector2i &start, const sf::Vector2i &end)
+bool PathFinder::isWalkable(const sf::Vector2i &position) const
 {
-    const float epsilon = 0.5f;
-    // Not in LOS if any of the ends is outside the polygon
-    auto it = std::find_if(std::begin(_walkboxes), std::end(_walkboxes), [start](const Walkbox &b) { return b.isEnabled() && b.inside(start); });
-    if (it == std::end(_walkboxes))
-    {
-        return false;
-    }
-
-    it = std::find_if(std::begin(_walkboxes), std::end(_walkboxes), [end](const Walkbox &b) { return b.isEnabled() && b.inside(end); });
-    if (it == std::end(_walkboxes))
-    {
-        return false;
-    }
+    return _walkboxGrid.inside(position, true);
+}
 
+// Not in LOS if any of the ends is outside the polygon, the caller checks them once for all the segments
+bool PathFinder::isSegmentClear(const sf::Vector2i &start, const sf::Vector2i &end)
+{
+    const float epsilon = 0.5f;
     // In LOS if it's the same start and end location
     if (length(start - end) < epsilon)
     {
@@ -321,28 +624,20 @@ bool PathFinder::inLineOfSight(const sf::Vector2i &start, const sf::Vector2i &en
     }
 
     // Not in LOS if any edge is intersected by the start-end line segment
-    for (const auto &walkbox : _walkboxes)
+    auto isBlocked = _edgeGrid->any(start, end, [&start, &end, epsilon](const sf::Vector2i &v1, const sf::Vector2i &v2) {
+        if (!lineSegmentsCross(start, end, v1, v2))
+            return false;
+
+        //In some cases a 'snapped' endpoint is just a little over the line due to rounding errors. So a 0.5 margin is used to tackle those cases.
+        return Walkbox::distanceToSegment(start, v1, v2) > epsilon && Walkbox::distanceToSegment(end, v1, v2) > epsilon;
+    });
+    if (isBlocked)
     {
-        auto size = walkbox.getVertices().size();
-        for (size_t i = 0; i < size; i++)
-        {
-            auto v1 = walkbox.getVertex(i);
-            auto v2 = walkbox.getVertex((i + 1) % size);
-            if (_isShared(v1, v2) || !lineSegmentsCross(start, end, v1, v2))
-                continue;
-
-            //In some cases a 'snapped' endpoint is just a little over the line due to rounding errors. So a 0.5 margin is used to tackle those cases.
-            if (Walkbox::distanceToSegment(start, v1, v2) > epsilon && Walkbox::distanceToSegment(end, v1, v2) > epsilon)
-            {
-                return false;
-            }
-        }
+        return false;
     }
 
     // Finally the middle point in the segment determines if in LOS or not
     sf::Vector2i v2 = (start + end) / 2;
-
-    it = std::find_if(std::begin(_walkboxes), std::end(_walkboxes), [v2](const Walkbox &b) { return b.isEnabled() && b.inside(v2); });
-    return it != std::end(_walkboxes);
+    return isWalkable(v2);
 }
 } // namespace ng
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include <iostream>
+#include "RenderStats.h"
+
+namespace ng
+{
+RenderStats &RenderStats::get()
+{
+    static RenderStats stats;
+    return stats;
+}
+
+void RenderStats::beginFrame()
+{
+    _current = RenderFrameStats();
+    _pLastTexture = nullptr;
+}
+
+void RenderStats::endFrame()
+{
+    _last = _current;
+    _frame++;
+    if (_csv.is_open())
+    {
+        writeCsvRow();
+    }
+}
+
+void RenderStats::addDrawCall(const sf::Texture *pTexture, std::size_t vertexCount)
+{
+    _current.drawCalls++;
+    _current.vertices += static_cast<unsigned int>(vertexCount);
+    if (pTexture != _pLastTexture)
+    {
+        _current.textureSwitches++;
+        _pLastTexture = pTexture;
+    }
+}
+
+void RenderStats::addTime(RenderStatsPhase phase, const sf::Time &time)
+{
+    _current.times[static_cast<size_t>(phase)] += time;
+}
+
+void RenderStats::setPresented(bool presented)
+{
+    _current.presented = presented;
+    if (presented)
+    {
+        _framesPresented++;
+    }
+    else
+    {
+        _framesSkipped++;
+    }
+}
+
+bool RenderStats::startCsv(const std::string &path)
+{
+    stopCsv();
+    _csv.open(path, std::ios::out | std::ios::trunc);
+    if (!_csv.is_open())
+    {
+        std::cerr << "Failed to open render stats file " << path << std::endl;
+        return false;
+    }
+
+    _csv << "frame,presented,drawCalls,vertices,textureSwitches,spritesCulled,textureUploads";
+    for (size_t i = 0; i < static_cast<size_t>(RenderStatsPhase::Count); i++)
+    {
+        _csv << ',' << getPhaseName(static_cast<RenderStatsPhase>(i)) << "_us";
+    }
+    _csv << '\n';
+    return true;
+}
+
+void RenderStats::stopCsv()
+{
+    if (_csv.is_open())
+    {
+        _csv.close();
+    }
+}
+
+void RenderStats::writeCsvRow()
+{
+    _csv << _frame << ',' << (_last.presented ? 1 : 0) << ',' << _last.drawCalls << ',' << _last.vertices << ',' << _last.textureSwitches << ','
+         << _last.spritesCulled << ',' << _last.textureUploads;
+    for (const auto &time : _last.times)
+    {
+        _csv << ',' << time.asMicroseconds();
+    }
+    _csv << '\n';
+}
+
+const char *RenderStats::getPhaseName(RenderStatsPhase phase)
+{
+    switch (phase)
+    {
+    case RenderStatsPhase::UpdateFunctions:
+        return "updateFunctions";
+    case RenderStatsPhase::UpdateRoom:
+        return "updateRoom";
+    case RenderStatsPhase::UpdateCurrentObject:
+        return "updateCurrentObject";
+    case RenderStatsPhase::UpdateCurrentActor:
+        return "updateCurrentActor";
+    case RenderStatsPhase::UpdateInventory:
+        return "updateInventory";
+    case RenderStatsPhase::UpdateDialog:
+        return "updateDialog";
+    case RenderStatsPhase::Draw:
+        return "draw";
+    default:
+        return "unknown";
+    }
+}
+} // namespace ng
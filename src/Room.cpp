@@ -13,16 +13,27 @@
 #include "RoomScaling.h"
 #include "SpriteSheet.h"
 #include "TextObject.h"
+#include "WalkboxGrid.h"
 #include "_NGUtil.h"
 
 namespace ng
 {
 struct Room::Impl
 {
+    // path finder over the walkboxes merged for one configuration of the enabled walkboxes
+    struct WalkGraph
+    {
+        std::vector<bool> enabledWalkboxes;
+        std::shared_ptr<PathFinder> pathFinder;
+    };
+    static constexpr size_t MaxWalkGraphs = 8;
+
     TextureManager &_textureManager;
     EngineSettings &_settings;
+    AnimationSystem _animationSystem;
     std::vector<std::unique_ptr<Object>> _objects;
     std::vector<Walkbox> _walkboxes;
+    WalkboxGrid _walkboxGrid;
     std::vector<std::unique_ptr<RoomLayer>> _layers;
     std::vector<RoomScaling> _scalings;
     RoomScaling _scaling;
@@ -34,11 +45,16 @@ struct Room::Impl
     int _fullscreen{0};
     HSQOBJECT _table;
     std::shared_ptr<Path> _path;
-    std::shared_ptr<PathFinder> _pf;
-    std::vector<Walkbox> _graphWalkboxes;
+    // the most recently used first
+    std::list<WalkGraph> _walkGraphs;
+    WalkGraph *_pWalkGraph{nullptr};
+    size_t _walkGraphHits{0};
     sf::Color _ambientColor{255, 255, 255, 255};
     SpriteSheet _spriteSheet;
     Room *_pRoom{nullptr};
+    bool _isDirty{true};
+    bool _precomputedPaths{false};
+    PathFinderMode _pathFinderMode{PathFinderMode::VisibilityGraph};
 
     Impl(TextureManager &textureManager, EngineSettings &settings)
         : _textureManager(textureManager),
@@ -195,7 +211,7 @@ struct Room::Impl
                 for (auto jAnimation : jObject["animations"].array_value)
                 {
                     auto animName = jAnimation["name"].string_value;
-                    auto anim = std::make_unique<Animation>(texture, animName);
+                    auto anim = std::make_unique<Animation>(_animationSystem, texture, animName);
                     if (!jAnimation["fps"].isNull())
                     {
                         anim->setFps(jAnimation["fps"].int_value);
@@ -328,17 +344,49 @@ struct Room::Impl
             }
             _walkboxes.push_back(walkbox);
         }
+        _walkboxGrid.build(_walkboxes);
+        _walkGraphs.clear();
         updateGraph();
     }
 
     void updateGraph()
     {
-        _graphWalkboxes.clear();
-        if (!_walkboxes.empty())
+        std::vector<bool> enabledWalkboxes;
+        enabledWalkboxes.reserve(_walkboxes.size());
+        for (const auto &walkbox : _walkboxes)
         {
-            merge(_walkboxes, _graphWalkboxes);
+            enabledWalkboxes.push_back(walkbox.isEnabled());
+        }
+
+        // puzzles toggle the same walkboxes back and forth, so the graphs are kept
+        auto it = std::find_if(_walkGraphs.begin(), _walkGraphs.end(), [&enabledWalkboxes](const WalkGraph &graph) {
+            return graph.enabledWalkboxes == enabledWalkboxes;
+        });
+        if (it != _walkGraphs.end())
+        {
+            _walkGraphHits++;
+            _walkGraphs.splice(_walkGraphs.begin(), _walkGraphs, it);
+        }
+        else
+        {
+            if (_walkGraphs.size() == MaxWalkGraphs)
+            {
+                _walkGraphs.pop_back();
+            }
+            auto &graph = _walkGraphs.emplace_front();
+            graph.enabledWalkboxes = std::move(enabledWalkboxes);
+            std::vector<Walkbox> walkboxes;
+            if (!_walkboxes.empty())
+            {
+                merge(_walkboxes, walkboxes);
+            }
+            graph.pathFinder = std::make_shared<PathFinder>(std::move(walkboxes), _pathFinderMode);
+        }
+        _pWalkGraph = &_walkGraphs.front();
+        if (_precomputedPaths)
+        {
+            _pWalkGraph->pathFinder->precomputePaths();
         }
-        _pf = std::make_shared<PathFinder>(_graphWalkboxes);
     }
 };
 
@@ -378,6 +426,10 @@ void Room::setAmbientLight(sf::Color color) { pImpl->_ambientColor = color; }
 
 sf::Color Room::getAmbientLight() const { return pImpl->_ambientColor; }
 
+void Room::setDirty(bool dirty) { pImpl->_isDirty = dirty; }
+
+bool Room::isDirty() const { return pImpl->_isDirty; }
+
 void Room::setAsParallaxLayer(Entity *pEntity, int layerNum)
 {
     auto itEndLayers = std::end(pImpl->_layers);
@@ -491,7 +543,7 @@ Object &Room::createObject(const std::string &sheet, const std::vector<std::stri
     auto json = nlohmann::json::parse(buffer.data());
 
     auto object = std::make_unique<Object>();
-    auto animation = std::make_unique<Animation>(texture, "state0");
+    auto animation = std::make_unique<Animation>(pImpl->_animationSystem, texture, "state0");
     for (const auto &n : anims)
     {
         if (json["frames"][n].is_null())
@@ -529,7 +581,7 @@ Object &Room::createObject(const std::string &image)
     auto &texture = pImpl->_textureManager.get(image);
 
     auto object = std::make_unique<Object>();
-    auto animation = std::make_unique<Animation>(texture, "state0");
+    auto animation = std::make_unique<Animation>(pImpl->_animationSystem, texture, "state0");
     auto size = texture.getSize();
     sf::IntRect rect(0, 0, size.x, size.y);
     animation->getRects().push_back(rect);
@@ -549,29 +601,35 @@ Object &Room::createObject(const std::string &image)
     return obj;
 }
 
-void Room::drawWalkboxes(sf::RenderWindow &window, sf::RenderStates states) const
+void Room::drawWalkboxes(sf::RenderTarget &target, sf::RenderStates states) const
 {
     if (!pImpl->_showDrawWalkboxes)
         return;
 
-    for (auto &walkbox : pImpl->_graphWalkboxes)
+    auto pWalkGraph = pImpl->_pWalkGraph;
+    if (pWalkGraph)
     {
-        window.draw(walkbox, states);
+        for (auto &walkbox : pWalkGraph->pathFinder->getWalkboxes())
+        {
+            target.draw(walkbox, states);
+        }
     }
 
     if (pImpl->_path)
     {
-        window.draw(*pImpl->_path);
+        target.draw(*pImpl->_path);
     }
 
-    if (pImpl->_pf && pImpl->_pf->getGraph())
+    auto graph = pWalkGraph ? pWalkGraph->pathFinder->getGraph() : nullptr;
+    if (graph)
     {
-        window.draw(*pImpl->_pf->getGraph(), states);
+        target.draw(*graph, states);
     }
 }
 
 void Room::update(const sf::Time &elapsed)
 {
+    pImpl->_animationSystem.update(elapsed);
     std::for_each(std::begin(pImpl->_layers), std::end(pImpl->_layers),
                   [elapsed](std::unique_ptr<RoomLayer> &layer) { layer->update(elapsed); });
 
@@ -580,10 +638,10 @@ void Room::update(const sf::Time &elapsed)
     });
 }
 
-void Room::draw(sf::RenderWindow &window, const sf::Vector2f &cameraPos) const
+void Room::draw(sf::RenderTarget &target, const sf::Vector2f &cameraPos) const
 {
     sf::RenderStates states;
-    auto screen = window.getView().getSize();
+    auto screen = target.getView().getSize();
     auto ratio = screen.y / pImpl->_roomSize.y;
     for (const auto &layer : pImpl->_layers)
     {
@@ -596,13 +654,13 @@ void Room::draw(sf::RenderWindow &window, const sf::Vector2f &cameraPos) const
         sf::Transform t;
         t.translate(posX, posY);
         states.transform = t;
-        layer->draw(window, states);
+        layer->draw(target, states);
     }
 
     sf::Transform t;
     t.translate(-cameraPos);
     states.transform = t;
-    drawWalkboxes(window, states);
+    drawWalkboxes(target, states);
 
     for (const auto &layer : pImpl->_layers)
     {
@@ -613,7 +671,7 @@ void Room::draw(sf::RenderWindow &window, const sf::Vector2f &cameraPos) const
         sf::Transform t2;
         t2.translate(posX, posY);
         states.transform = t2;
-        layer->drawForeground(window, states);
+        layer->drawForeground(target, states);
     }
 }
 
@@ -643,10 +701,7 @@ void Room::setWalkboxEnabled(const std::string &name, bool isEnabled)
 
 bool Room::inWalkbox(const sf::Vector2f &pos) const
 {
-    auto inWalkbox = std::any_of(pImpl->_walkboxes.begin(), pImpl->_walkboxes.end(), [pos](const Walkbox &w) {
-        return w.inside((sf::Vector2i)pos);
-    });
-    return inWalkbox;
+    return pImpl->_walkboxGrid.inside((sf::Vector2i)pos, false);
 }
 
 std::vector<RoomScaling>& Room::getScalings()
@@ -654,9 +709,36 @@ std::vector<RoomScaling>& Room::getScalings()
     return pImpl->_scalings;
 }
 
-std::vector<sf::Vector2i> Room::calculatePath(const sf::Vector2i &start, const sf::Vector2i &end) const
+void Room::setPrecomputedPaths(bool enabled)
+{
+    pImpl->_precomputedPaths = enabled;
+    if (enabled && pImpl->_pWalkGraph)
+    {
+        pImpl->_pWalkGraph->pathFinder->precomputePaths();
+    }
+}
+
+void Room::setPathFinderMode(PathFinderMode mode)
+{
+    if (pImpl->_pathFinderMode == mode)
+        return;
+    pImpl->_pathFinderMode = mode;
+    pImpl->_walkGraphs.clear();
+    pImpl->_pWalkGraph = nullptr;
+    if (!pImpl->_walkboxes.empty())
+    {
+        pImpl->updateGraph();
+    }
+}
+
+std::shared_ptr<PathFinder> Room::getPathFinder() const
+{
+    return pImpl->_pWalkGraph ? pImpl->_pWalkGraph->pathFinder : nullptr;
+}
+
+size_t Room::getWalkGraphCacheHits() const
 {
-    return pImpl->_pf->calculatePath(start, end);
+    return pImpl->_walkGraphHits;
 }
 
 } // namespace ng
@@ -1,4 +1,5 @@
 #include "RoomLayer.h"
+#include "RenderStats.h"
 
 namespace ng
 {
@@ -23,10 +24,20 @@ void RoomLayer::draw(sf::RenderTarget &target, sf::RenderStates states) const
 {
     if(!_enabled) return;
     
-    // draw layer sprites
+    // draw layer sprites, skipping the ones outside of the view
+    const auto &view = target.getView();
+    sf::FloatRect viewRect(view.getCenter() - view.getSize() / 2.f, view.getSize());
+    auto &stats = RenderStats::get();
     for (const auto &sprite : getSprites())
     {
+        auto bounds = states.transform.transformRect(sprite.getGlobalBounds());
+        if (!viewRect.intersects(bounds))
+        {
+            stats.addCulledSprite();
+            continue;
+        }
         target.draw(sprite, states);
+        stats.addDrawCall(sprite.getTexture(), 4);
     }
 
     // draw layer objects
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "ScriptCache.h"
+
+namespace ng
+{
+static const char ScriptCacheMagic[4] = {'N', 'G', 'B', 'C'};
+// to change when the format of the file or the bytecode of the compiler changes
+static const uint32_t ScriptCacheVersion = 1;
+
+static SQInteger _writeStream(SQUserPointer up, SQUserPointer data, SQInteger size)
+{
+    auto &output = *static_cast<std::ofstream *>(up);
+    output.write(static_cast<const char *>(data), size);
+    return output ? size : -1;
+}
+
+static SQInteger _readStream(SQUserPointer up, SQUserPointer data, SQInteger size)
+{
+    auto &input = *static_cast<std::ifstream *>(up);
+    input.read(static_cast<char *>(data), size);
+    return input ? size : -1;
+}
+
+ScriptCache::ScriptCache(std::string directory)
+    : _directory(std::move(directory))
+{
+}
+
+// FNV-1a
+uint64_t ScriptCache::hash(const std::vector<char> &data)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (auto c : data)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string ScriptCache::getPath(const std::string &name) const
+{
+    return (std::filesystem::path(_directory) / (name + ".cnut")).string();
+}
+
+bool ScriptCache::readHeader(std::istream &input, uint64_t hash)
+{
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t squirrelVersion = 0;
+    uint64_t scriptHash = 0;
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char *>(&version), sizeof(version));
+    input.read(reinterpret_cast<char *>(&squirrelVersion), sizeof(squirrelVersion));
+    input.read(reinterpret_cast<char *>(&scriptHash), sizeof(scriptHash));
+    return input && std::equal(magic, magic + 4, ScriptCacheMagic) && version == ScriptCacheVersion &&
+           squirrelVersion == SQUIRREL_VERSION_NUMBER && scriptHash == hash;
+}
+
+bool ScriptCache::contains(const std::string &name, uint64_t hash) const
+{
+    std::ifstream input(getPath(name), std::ios::binary);
+    return input.is_open() && readHeader(input, hash);
+}
+
+bool ScriptCache::load(HSQUIRRELVM v, const std::string &name, uint64_t hash) const
+{
+    std::ifstream input(getPath(name), std::ios::binary);
+    if (!input.is_open() || !readHeader(input, hash))
+        return false;
+
+    auto top = sq_gettop(v);
+    if (SQ_FAILED(sq_readclosure(v, _readStream, &input)))
+    {
+        std::cerr << "Invalid compiled script " << getPath(name) << std::endl;
+        sq_settop(v, top);
+        return false;
+    }
+    return true;
+}
+
+bool ScriptCache::save(HSQUIRRELVM v, const std::string &name, uint64_t hash) const
+{
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    auto path = getPath(name);
+    // the file is written aside and renamed once complete, so a valid header is never followed by a partial body
+    std::ostringstream temporaryPath;
+    temporaryPath << path << '.' << std::this_thread::get_id() << ".tmp";
+    std::ofstream output(temporaryPath.str(), std::ios::binary);
+    if (!output.is_open())
+    {
+        std::cerr << "Unable to write compiled script " << path << std::endl;
+        return false;
+    }
+
+    uint32_t squirrelVersion = SQUIRREL_VERSION_NUMBER;
+    output.write(ScriptCacheMagic, sizeof(ScriptCacheMagic));
+    output.write(reinterpret_cast<const char *>(&ScriptCacheVersion), sizeof(ScriptCacheVersion));
+    output.write(reinterpret_cast<const char *>(&squirrelVersion), sizeof(squirrelVersion));
+    output.write(reinterpret_cast<const char *>(&hash), sizeof(hash));
+    auto isWritten = SQ_SUCCEEDED(sq_writeclosure(v, _writeStream, &output)) && output;
+    output.close();
+    if (isWritten && output)
+    {
+        std::filesystem::rename(temporaryPath.str(), path, error);
+        isWritten = !error;
+    }
+    if (!isWritten)
+    {
+        std::cerr << "Unable to write compiled script " << path << std::endl;
+        std::filesystem::remove(temporaryPath.str(), error);
+        return false;
+    }
+    return true;
+}
+} // namespace ng
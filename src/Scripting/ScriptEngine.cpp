@@ -1,4 +1,5 @@
 #include <stdarg.h>
+#include <unordered_set>
 #include "squirrel.h"
 #include "sqstdio.h"
 #include "sqstdaux.h"
@@ -6,6 +7,7 @@
 #include "sqstdmath.h"
 #include "ScriptEngine.h"
 #include "SoundDefinition.h"
+#include "ThreadPool.h"
 #include "VerbExecute.h"
 #include "_SystemPack.h"
 #include "_GeneralPack.h"
@@ -296,12 +298,14 @@ ScriptEngine::ScriptEngine(Engine &engine)
 
     auto pVerbExecute = std::make_unique<_DefaultVerbExecute>(v, engine);
     engine.setVerbExecute(std::move(pVerbExecute));
-    auto pScriptExecute = std::make_unique<_DefaultScriptExecute>(v);
+    auto pScriptExecute = std::make_unique<_DefaultScriptExecute>(v, engine.getSoundManager());
     engine.setScriptExecute(std::move(pScriptExecute));
 }
 
 ScriptEngine::~ScriptEngine()
 {
+    // the script executor holds compiled code of the VM
+    _engine.setScriptExecute(nullptr);
     sq_close(v);
 }
 
@@ -415,9 +419,20 @@ void ScriptEngine::executeScript(const std::string &name)
     }
 }
 
+static void _decodeBnut(std::vector<char> &code)
+{
+    int cursor = code.size() & 0xff;
+    for (char &i : code)
+    {
+        i ^= _bnutPass[cursor];
+        cursor = (cursor + 1) % 4096;
+    }
+}
+
 void ScriptEngine::executeNutScript(const std::string &name)
 {
     std::vector<char> code;
+    auto isEncoded = false;
 
     std::ifstream is(name);
     if (is.is_open())
@@ -433,40 +448,116 @@ void ScriptEngine::executeNutScript(const std::string &name)
     {
         auto entryName = std::regex_replace(name, std::regex("\\.nut"), ".bnut");
         _engine.getSettings().readEntry(entryName, code);
-
-        // decode bnut
-        int cursor = code.size() & 0xff;
-        for (char & i : code)
-        {
-            i ^= _bnutPass[cursor];
-            cursor = (cursor + 1) % 4096;
-        }
+        isEncoded = true;
     }
 
-#if 1
-    std::ofstream o;
-    o.open(name);
-    o.write(code.data(), code.size());
-    o.close();
-#endif
+    // the script is hashed as stored, so a script found in the cache is neither decoded nor compiled
+    auto hash = ScriptCache::hash(code);
     auto top = sq_gettop(v);
-    sq_pushroottable(v);
-    if (SQ_FAILED(sq_compilebuffer(v, code.data(), code.size() - 1, _SC(name.data()), SQTrue)))
+    if (!_scriptCache.load(v, name, hash))
     {
-        std::cerr << "Error compiling " << name << std::endl;
-        return;
+        if (isEncoded)
+        {
+            _decodeBnut(code);
+        }
+
+        if (SQ_FAILED(sq_compilebuffer(v, code.data(), code.size() - 1, _SC(name.data()), SQTrue)))
+        {
+            std::cerr << "Error compiling " << name << std::endl;
+            sq_settop(v, top);
+            return;
+        }
+        _scriptCache.save(v, name, hash);
     }
-    sq_push(v, -2);
+    sq_pushroottable(v);
     // call
     if (SQ_FAILED(sq_call(v, 1, SQFalse, SQTrue)))
     {
         std::cerr << "Error calling " << name << std::endl;
         sqstd_printcallstack(v);
+        sq_settop(v, top);
         return;
     }
     sq_settop(v, top);
 }
 
+void ScriptEngine::compileScripts()
+{
+    struct Script
+    {
+        std::string name;
+        std::vector<char> code;
+        uint64_t hash;
+    };
+
+    // the packs are read on this thread, they can't be shared
+    std::vector<std::string> entries;
+    _engine.getSettings().getEntries(entries);
+    std::vector<Script> scripts;
+    // a script in both packs is compiled once, from the first pack like readEntry does,
+    // two jobs would write the same cache file at the same time
+    std::unordered_set<std::string> names;
+    for (const auto &entry : entries)
+    {
+        if (entry.size() < 5 || entry.compare(entry.size() - 5, 5, ".bnut") != 0)
+            continue;
+        if (!names.insert(entry).second)
+            continue;
+
+        // a local file replaces the script of the pack
+        auto name = entry.substr(0, entry.size() - 5) + ".nut";
+        if (std::ifstream(name).is_open())
+            continue;
+
+        Script script;
+        script.name = name;
+        _engine.getSettings().readEntry(entry, script.code);
+        script.hash = ScriptCache::hash(script.code);
+        if (script.code.empty() || _scriptCache.contains(name, script.hash))
+            continue;
+        scripts.push_back(std::move(script));
+    }
+    if (scripts.empty())
+        return;
+
+    sf::Clock clock;
+    auto threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::future<sf::Time>> results;
+    {
+        ThreadPool threadPool(threadCount);
+        for (auto &script : scripts)
+        {
+            results.push_back(threadPool.submit([&script, this]() {
+                sf::Clock scriptClock;
+                auto vm = sq_open(1024);
+                sq_setcompilererrorhandler(vm, errorHandler);
+                _decodeBnut(script.code);
+                if (SQ_FAILED(sq_compilebuffer(vm, script.code.data(), script.code.size() - 1, _SC(script.name.data()), SQTrue)))
+                {
+                    std::cerr << "Error compiling " << script.name << std::endl;
+                }
+                else
+                {
+                    _scriptCache.save(vm, script.name, script.hash);
+                }
+                sq_close(vm);
+                return scriptClock.getElapsedTime();
+            }));
+        }
+        for (auto &result : results)
+        {
+            result.wait();
+        }
+    }
+
+    for (size_t i = 0; i < scripts.size(); i++)
+    {
+        std::cout << "Compiled " << scripts[i].name << " in " << results[i].get().asMicroseconds() / 1000.f << " ms" << std::endl;
+    }
+    std::cout << "Compiled " << scripts.size() << " scripts on " << threadCount << " threads in "
+              << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+}
+
 void ScriptEngine::executeBootScript()
 {
     executeNutScript("Defines.nut");
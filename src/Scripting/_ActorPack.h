@@ -834,7 +834,7 @@ private:
         {
             return sq_throwerror(v, _SC("failed to get actor"));
         }
-        auto screen = g_pEngine->getWindow().getView().getSize();
+        auto screen = g_pEngine->getView().getSize();
         auto pos = (sf::Vector2i)actor->getPosition();
         auto camera = g_pEngine->getCameraAt();
         sf::IntRect rect(camera.x - screen.x / 2.f, camera.y - screen.y / 2.f, screen.x, screen.y);
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <chrono>
+#include <list>
+#include <string_view>
+#include <unordered_map>
 #include "squirrel.h"
 #include "Engine.h"
 #include "ScriptExecute.h"
+#include "SoundManager.h"
 #include "../_NGUtil.h"
 
 namespace ng
@@ -10,33 +15,54 @@ namespace ng
 class _DefaultScriptExecute : public ScriptExecute
 {
 public:
-    explicit _DefaultScriptExecute(HSQUIRRELVM vm)
-        : _vm(vm)
+    _DefaultScriptExecute(HSQUIRRELVM vm, SoundManager &soundManager)
+        : _vm(vm), _soundManager(soundManager)
     {
     }
 
+    ~_DefaultScriptExecute() override
+    {
+        for (auto &code : _codes)
+        {
+            sq_release(_vm, &code.closure);
+        }
+    }
+
 public:
     void execute(const std::string &code) override
     {
+        auto start = std::chrono::steady_clock::now();
         sq_resetobject(&_result);
         _pos = 0;
         auto top = sq_gettop(_vm);
-        // compile
-        sq_pushroottable(_vm);
-        if (SQ_FAILED(sq_compilebuffer(_vm, code.data(), code.size(), _SC("_DefaultScriptExecute"), SQTrue)))
+        auto isCached = false;
+        if (!pushClosure(code, isCached))
         {
             std::cerr << "Error executing code " << code << std::endl;
             return;
         }
-        sq_push(_vm, -2);
+        sq_pushroottable(_vm);
         // call
         if (SQ_FAILED(sq_call(_vm, 1, SQTrue, SQTrue)))
         {
             std::cerr << "Error calling code " << code << std::endl;
+            sq_settop(_vm, top);
             return;
         }
         sq_getstackobj(_vm, -1, &_result);
         sq_settop(_vm, top);
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (isCached)
+        {
+            _stats.cacheHits++;
+            _stats.cacheHitTime += elapsed;
+        }
+        else
+        {
+            _stats.compiles++;
+            _stats.compileTime += elapsed;
+        }
     }
 
     bool executeCondition(const std::string &code) override
@@ -81,11 +107,18 @@ public:
 
     std::shared_ptr<SoundDefinition> getSoundDefinition(const std::string &name) override
     {
+        auto top = sq_gettop(_vm);
         sq_pushroottable(_vm);
         sq_pushstring(_vm, name.data(), -1);
-        sq_get(_vm, -2);
+        if (SQ_FAILED(sq_get(_vm, -2)))
+        {
+            sq_settop(_vm, top);
+            std::cerr << "getSoundDefinition: sound " << name << " not found" << std::endl;
+            return nullptr;
+        }
         HSQOBJECT obj;
         sq_getstackobj(_vm, -1, &obj);
+        sq_settop(_vm, top);
 
         if (!sq_isuserpointer(obj))
         {
@@ -93,15 +126,61 @@ public:
             return nullptr;
         }
 
-        std::shared_ptr<SoundDefinition> pSound = std::shared_ptr<SoundDefinition>(
-            static_cast<SoundDefinition *>(obj._unVal.pUserPointer));
-        return pSound;
+        // the sound manager owns the sound definitions created by the scripts
+        return _soundManager.getSoundDefinition(obj._unVal.pUserPointer);
     }
 
+    const ScriptExecuteStats &getStats() const override { return _stats; }
+
 private:
+    struct CompiledCode
+    {
+        std::string code;
+        HSQOBJECT closure;
+    };
+
+    // pushes the closure of the code, taken from the cache or compiled
+    bool pushClosure(const std::string &code, bool &isCached)
+    {
+        auto it = _closures.find(code);
+        isCached = it != _closures.end();
+        if (isCached)
+        {
+            _codes.splice(_codes.begin(), _codes, it->second);
+            sq_pushobject(_vm, it->second->closure);
+            return true;
+        }
+
+        if (SQ_FAILED(sq_compilebuffer(_vm, code.data(), code.size(), _SC("_DefaultScriptExecute"), SQTrue)))
+            return false;
+
+        if (_codes.size() == MaxCompiledCodes)
+        {
+            auto &last = _codes.back();
+            _closures.erase(last.code);
+            sq_release(_vm, &last.closure);
+            _codes.pop_back();
+        }
+        auto &compiledCode = _codes.emplace_front();
+        compiledCode.code = code;
+        sq_getstackobj(_vm, -1, &compiledCode.closure);
+        sq_addref(_vm, &compiledCode.closure);
+        _closures[compiledCode.code] = _codes.begin();
+        return true;
+    }
+
+private:
+    // dialog conditions and yack code are executed again each time a dialog is shown
+    static constexpr size_t MaxCompiledCodes = 256;
+
     static int _pos;
     HSQUIRRELVM _vm;
+    SoundManager &_soundManager;
     HSQOBJECT _result;
+    // the most recently used first, the keys of the map are the codes of the list
+    std::list<CompiledCode> _codes;
+    std::unordered_map<std::string_view, std::list<CompiledCode>::iterator> _closures;
+    ScriptExecuteStats _stats;
 };
 
 int _DefaultScriptExecute::_pos = 0;
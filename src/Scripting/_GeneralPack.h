@@ -256,7 +256,7 @@ private:
     static SQInteger cameraAt(HSQUIRRELVM v)
     {
         std::cout << "cameraAt" << std::endl;
-        auto screen = g_pEngine->getWindow().getView().getSize();
+        auto screen = g_pEngine->getView().getSize();
         SQInteger x, y;
         auto numArgs = sq_gettop(v) - 1;
         if (numArgs == 2)
@@ -320,7 +320,7 @@ private:
     static SQInteger cameraPanTo(HSQUIRRELVM v)
     {
         SQInteger x, y, interpolation{0};
-        auto screen = g_pEngine->getWindow().getView().getSize();
+        auto screen = g_pEngine->getView().getSize();
         SQFloat t;
         if (sq_gettype(v, 2) == OT_TABLE)
         {
@@ -539,7 +539,7 @@ private:
 
     static SQInteger screenSize(HSQUIRRELVM v)
     {
-        auto screen = g_pEngine->getWindow().getView().getSize();
+        auto screen = g_pEngine->getView().getSize();
         sq_newtable(v);
         sq_pushstring(v, _SC("x"), -1);
         sq_pushinteger(v, screen.x);
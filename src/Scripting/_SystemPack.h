@@ -93,6 +93,11 @@ public:
         return "_BreakFunction";
     }
 
+    bool isIdle() override
+    {
+        return true;
+    }
+
     void operator()(const sf::Time &elapsed) override
     {
         if (_done)
@@ -161,11 +166,11 @@ public:
 class _BreakWhileAnimatingObjectFunction : public _BreakFunction
 {
 private:
-    std::optional<Animation> &_animation;
+    Object &_object;
 
 public:
     _BreakWhileAnimatingObjectFunction(Engine &engine, HSQUIRRELVM vm, Object &object)
-        : _BreakFunction(engine, vm), _animation(object.getAnimation())
+        : _BreakFunction(engine, vm), _object(object)
     {
     }
 
@@ -176,7 +181,8 @@ public:
 
     bool isElapsed() override
     {
-        return !_animation.has_value() || !_animation.value().isPlaying();
+        auto pAnimation = _object.getAnimation();
+        return !pAnimation || !pAnimation->isPlaying();
     }
 };
 
@@ -260,6 +266,11 @@ public:
     {
     }
 
+    bool isIdle() override
+    {
+        return true;
+    }
+
     void operator()(const sf::Time &elapsed) override
     {
         if (_done)
@@ -350,6 +361,11 @@ public:
     {
     }
 
+    bool isIdle() override
+    {
+        return true;
+    }
+
     void operator()(const sf::Time &elapsed) override
     {
         if (_done)
@@ -383,6 +399,11 @@ public:
         sq_addref(_v, &_method);
     }
 
+    bool isIdle() override
+    {
+        return true;
+    }
+
 private:
     void onElapsed() override
     {
@@ -0,0 +1,57 @@
+#include <cmath>
+#include "SpriteBatch.h"
+#include "RenderStats.h"
+
+namespace ng
+{
+SpriteBatch::SpriteBatch()
+    : _vertices(sf::Triangles)
+{
+}
+
+void SpriteBatch::clear()
+{
+    _vertices.clear();
+}
+
+void SpriteBatch::add(const sf::Sprite &sprite)
+{
+    auto rect = sprite.getTextureRect();
+    sf::Vector2f size(std::abs(rect.width), std::abs(rect.height));
+    addQuad(sprite.getTransform(), size, rect, sprite.getColor());
+}
+
+void SpriteBatch::add(const sf::RectangleShape &shape)
+{
+    addQuad(shape.getTransform(), shape.getSize(), shape.getTextureRect(), shape.getFillColor());
+}
+
+void SpriteBatch::addQuad(const sf::Transform &transform, const sf::Vector2f &size, const sf::IntRect &textureRect, const sf::Color &color)
+{
+    auto topLeft = transform.transformPoint(0, 0);
+    auto topRight = transform.transformPoint(size.x, 0);
+    auto bottomLeft = transform.transformPoint(0, size.y);
+    auto bottomRight = transform.transformPoint(size.x, size.y);
+
+    float u1 = textureRect.left;
+    float v1 = textureRect.top;
+    float u2 = textureRect.left + textureRect.width;
+    float v2 = textureRect.top + textureRect.height;
+
+    _vertices.append(sf::Vertex(topLeft, color, sf::Vector2f(u1, v1)));
+    _vertices.append(sf::Vertex(topRight, color, sf::Vector2f(u2, v1)));
+    _vertices.append(sf::Vertex(bottomLeft, color, sf::Vector2f(u1, v2)));
+    _vertices.append(sf::Vertex(bottomLeft, color, sf::Vector2f(u1, v2)));
+    _vertices.append(sf::Vertex(topRight, color, sf::Vector2f(u2, v1)));
+    _vertices.append(sf::Vertex(bottomRight, color, sf::Vector2f(u2, v2)));
+}
+
+void SpriteBatch::draw(sf::RenderTarget &target, sf::RenderStates states) const
+{
+    if (isEmpty())
+        return;
+    states.texture = _pTexture;
+    target.draw(_vertices, states);
+    RenderStats::get().addDrawCall(_pTexture, _vertices.getVertexCount());
+}
+} // namespace ng
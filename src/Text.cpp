@@ -1,5 +1,6 @@
 #include <cmath>
 #include "Text.h"
+#include "RenderStats.h"
 #include "SFML/Graphics/Text.hpp"
 #include "SFML/Graphics/Texture.hpp"
 #include "SFML/Graphics/RenderTarget.hpp"
@@ -317,9 +318,13 @@ void Text::draw(sf::RenderTarget &target, sf::RenderStates states) const
 
         // Only draw the outline if there is something to draw
         if (m_outlineThickness != 0)
+        {
             target.draw(m_outlineVertices, states);
+            RenderStats::get().addDrawCall(states.texture, m_outlineVertices.getVertexCount());
+        }
 
         target.draw(m_vertices, states);
+        RenderStats::get().addDrawCall(states.texture, m_vertices.getVertexCount());
     }
 }
 
@@ -1,5 +1,6 @@
 #include <iostream>
 #include "TextureManager.h"
+#include "RenderStats.h"
 
 namespace ng
 {
@@ -29,6 +30,7 @@ void TextureManager::load(const std::string &id)
     {
         std::cerr << "Fail to load texture " << path << std::endl;
     }
+    RenderStats::get().addTextureUpload();
 
     _textureMap.insert(std::make_pair(id, texture));
 }
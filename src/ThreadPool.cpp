@@ -0,0 +1,43 @@
+#include "ThreadPool.h"
+
+namespace ng
+{
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        _threads.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopped = true;
+        _jobs.clear();
+    }
+    _condition.notify_all();
+    for (auto &thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::run()
+{
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this] { return _isStopped || !_jobs.empty(); });
+            if (_isStopped)
+                return;
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        job();
+    }
+}
+} // namespace ng
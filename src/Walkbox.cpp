@@ -10,17 +10,35 @@ namespace ng
 Walkbox::Walkbox() = default;
 
 Walkbox::Walkbox(const Walkbox &w)
-    : _polygon(w._polygon), _name(w._name), _isEnabled(w._isEnabled), _color(w._color)
+    : _polygon(w._polygon), _bounds(w._bounds), _name(w._name), _isEnabled(w._isEnabled), _color(w._color)
 {
 }
 
 Walkbox::Walkbox(std::vector<sf::Vector2i> polygon)
     : _polygon(std::move(polygon)), _isEnabled(true), _color(sf::Color::Green)
 {
+    updateBounds();
 }
 
 Walkbox::~Walkbox() = default;
 
+void Walkbox::updateBounds()
+{
+    if (_polygon.empty())
+        return;
+
+    auto min = _polygon[0];
+    auto max = _polygon[0];
+    for (const auto &vertex : _polygon)
+    {
+        min.x = std::min(min.x, vertex.x);
+        min.y = std::min(min.y, vertex.y);
+        max.x = std::max(max.x, vertex.x);
+        max.y = std::max(max.y, vertex.y);
+    }
+    _bounds = sf::IntRect(min.x, min.y, max.x - min.x, max.y - min.y);
+}
+
 float Walkbox::distanceToSegment(const sf::Vector2i &p, const sf::Vector2i &v, const sf::Vector2i &w)
 {
     return sqrt(distanceToSegmentSquared(p, v, w));
@@ -125,6 +143,11 @@ bool Walkbox::inside(const sf::Vector2i &position, bool toleranceOnOutside) cons
     if (_polygon.size() < 3)
         return false;
 
+    // the tolerance only applies to the positions closer than 1 to an edge
+    if (point.x < _bounds.left - 1 || point.y < _bounds.top - 1 ||
+        point.x > _bounds.left + _bounds.width + 1 || point.y > _bounds.top + _bounds.height + 1)
+        return false;
+
     sf::Vector2i oldPoint = _polygon[_polygon.size() - 1];
     float oldSqDist = distanceSquared(oldPoint, point);
 
@@ -132,7 +155,9 @@ bool Walkbox::inside(const sf::Vector2i &position, bool toleranceOnOutside) cons
     {
         float newSqDist = distanceSquared(newPoint, point);
 
-        if (oldSqDist + newSqDist + 2.0f * sqrt(oldSqDist * newSqDist) - distanceSquared(newPoint, oldPoint) < epsilon)
+        // on the edge when (d1 + d2)^2 - length^2 < epsilon, squared again to avoid the square root of d1^2 * d2^2
+        auto margin = epsilon + distanceSquared(newPoint, oldPoint) - oldSqDist - newSqDist;
+        if (margin > 0 && 4.0 * oldSqDist * newSqDist < static_cast<double>(margin) * margin)
             return toleranceOnOutside;
 
         sf::Vector2i left;
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "WalkboxGrid.h"
+#include "_NGUtil.h"
+
+namespace ng
+{
+// positions closer than this to an edge can be on the edge for Walkbox::inside
+static const int EdgeMargin = 1;
+
+static bool _segmentIntersectsRect(const sf::Vector2i &v1, const sf::Vector2i &v2, const sf::IntRect &rect)
+{
+    auto right = rect.left + rect.width;
+    auto bottom = rect.top + rect.height;
+    if (std::max(v1.x, v2.x) < rect.left || std::min(v1.x, v2.x) > right ||
+        std::max(v1.y, v2.y) < rect.top || std::min(v1.y, v2.y) > bottom)
+        return false;
+
+    // the segment misses the rectangle when all the corners are on the same side of its line
+    auto side = [&v1, &v2](int x, int y) {
+        return static_cast<int64_t>(v2.x - v1.x) * (y - v1.y) - static_cast<int64_t>(v2.y - v1.y) * (x - v1.x);
+    };
+    auto s1 = side(rect.left, rect.top);
+    auto s2 = side(right, rect.top);
+    auto s3 = side(right, bottom);
+    auto s4 = side(rect.left, bottom);
+    if (s1 > 0 && s2 > 0 && s3 > 0 && s4 > 0)
+        return false;
+    if (s1 < 0 && s2 < 0 && s3 < 0 && s4 < 0)
+        return false;
+    return true;
+}
+
+void WalkboxGrid::build(const std::vector<Walkbox> &walkboxes)
+{
+    _pWalkboxes = &walkboxes;
+    _offsets.clear();
+    _entries.clear();
+
+    sf::Vector2i min(std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
+    sf::Vector2i max(std::numeric_limits<int>::min(), std::numeric_limits<int>::min());
+    size_t edgeCount = 0;
+    for (const auto &walkbox : walkboxes)
+    {
+        if (walkbox.getVertices().size() < 3)
+            continue;
+        const auto &bounds = walkbox.getBounds();
+        min.x = std::min(min.x, bounds.left);
+        min.y = std::min(min.y, bounds.top);
+        max.x = std::max(max.x, bounds.left + bounds.width);
+        max.y = std::max(max.y, bounds.top + bounds.height);
+        edgeCount += walkbox.getVertices().size();
+    }
+    if (edgeCount == 0)
+        return;
+
+    // a few cells per edge, so most of the cells are away from the edges
+    _origin = min - sf::Vector2i(EdgeMargin, EdgeMargin);
+    auto width = max.x - min.x + 2 * EdgeMargin + 1;
+    auto height = max.y - min.y + 2 * EdgeMargin + 1;
+    auto area = static_cast<float>(width) * static_cast<float>(height);
+    _cellSize = std::max(4, static_cast<int>(std::ceil(std::sqrt(area / (4 * edgeCount)))));
+    _size.x = (width + _cellSize - 1) / _cellSize;
+    _size.y = (height + _cellSize - 1) / _cellSize;
+
+    std::vector<std::vector<Entry>> cells(_size.x * _size.y);
+    std::vector<bool> isOnEdge(cells.size());
+    for (uint32_t i = 0; i < walkboxes.size(); i++)
+    {
+        const auto &walkbox = walkboxes[i];
+        if (walkbox.getVertices().size() < 3)
+            continue;
+
+        const auto &bounds = walkbox.getBounds();
+        auto left = (bounds.left - EdgeMargin - _origin.x) / _cellSize;
+        auto top = (bounds.top - EdgeMargin - _origin.y) / _cellSize;
+        auto right = (bounds.left + bounds.width + EdgeMargin - _origin.x) / _cellSize;
+        auto bottom = (bounds.top + bounds.height + EdgeMargin - _origin.y) / _cellSize;
+
+        // the cells close to an edge
+        for (auto y = top; y <= bottom; y++)
+        {
+            std::fill(isOnEdge.begin() + y * _size.x + left, isOnEdge.begin() + y * _size.x + right + 1, false);
+        }
+        forEachWalkboxEdge(walkbox, [&](const sf::Vector2i &v1, const sf::Vector2i &v2) {
+            auto x1 = (std::min(v1.x, v2.x) - EdgeMargin - _origin.x) / _cellSize;
+            auto x2 = (std::max(v1.x, v2.x) + EdgeMargin - _origin.x) / _cellSize;
+            auto y1 = (std::min(v1.y, v2.y) - EdgeMargin - _origin.y) / _cellSize;
+            auto y2 = (std::max(v1.y, v2.y) + EdgeMargin - _origin.y) / _cellSize;
+            for (auto y = y1; y <= y2; y++)
+            {
+                for (auto x = x1; x <= x2; x++)
+                {
+                    sf::IntRect rect(_origin.x + x * _cellSize - EdgeMargin, _origin.y + y * _cellSize - EdgeMargin,
+                                     _cellSize + 2 * EdgeMargin, _cellSize + 2 * EdgeMargin);
+                    if (_segmentIntersectsRect(v1, v2, rect))
+                    {
+                        isOnEdge[y * _size.x + x] = true;
+                    }
+                }
+            }
+        });
+
+        // the other cells are entirely inside or outside, a row only changes at the cells close to an edge
+        for (auto y = top; y <= bottom; y++)
+        {
+            bool isKnown = false;
+            bool isInside = false;
+            for (auto x = left; x <= right; x++)
+            {
+                auto cell = y * _size.x + x;
+                if (isOnEdge[cell])
+                {
+                    cells[cell].push_back({i, true});
+                    isKnown = false;
+                    continue;
+                }
+                if (!isKnown)
+                {
+                    isInside = walkbox.inside(sf::Vector2i(_origin.x + x * _cellSize, _origin.y + y * _cellSize));
+                    isKnown = true;
+                }
+                if (isInside)
+                {
+                    cells[cell].push_back({i, false});
+                }
+            }
+        }
+    }
+
+    _offsets.resize(cells.size() + 1);
+    _offsets[0] = 0;
+    for (size_t i = 0; i < cells.size(); i++)
+    {
+        _offsets[i + 1] = _offsets[i] + static_cast<uint32_t>(cells[i].size());
+        _entries.insert(_entries.end(), cells[i].begin(), cells[i].end());
+    }
+}
+
+bool WalkboxGrid::inside(const sf::Vector2i &position, bool enabledOnly) const
+{
+    if (_offsets.empty())
+        return false;
+
+    // every walkbox is in the grid
+    auto x = position.x - _origin.x;
+    auto y = position.y - _origin.y;
+    if (x < 0 || y < 0 || x >= _size.x * _cellSize || y >= _size.y * _cellSize)
+        return false;
+
+    auto cell = (y / _cellSize) * _size.x + x / _cellSize;
+    for (auto i = _offsets[cell]; i < _offsets[cell + 1]; i++)
+    {
+        const auto &entry = _entries[i];
+        const auto &walkbox = (*_pWalkboxes)[entry.walkbox];
+        if (enabledOnly && !walkbox.isEnabled())
+            continue;
+        if (!entry.isOnEdge || walkbox.inside(position))
+            return true;
+    }
+    return false;
+}
+} // namespace ng
@@ -0,0 +1,103 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+
+namespace ng
+{
+// Indexed 4-ary min heap of nodes ordered by their key, the position of each node is tracked
+// so the key of a node in the heap can be decreased in O(log n).
+class _IndexedPriorityQueue
+{
+    static constexpr size_t Arity = 4;
+
+    std::vector<float> &_keys;
+    std::vector<int> &_data;
+    std::vector<int> &_positions;
+
+  public:
+    _IndexedPriorityQueue(std::vector<float> &keys, std::vector<int> &data, std::vector<int> &positions)
+        : _keys(keys), _data(data), _positions(positions)
+    {
+        _data.clear();
+        _positions.assign(_keys.size(), -1);
+    }
+
+    void insert(int index)
+    {
+        _data.push_back(index);
+        siftUp(_data.size() - 1);
+    }
+
+    int pop()
+    {
+        int r = _data[0];
+        _positions[r] = -1;
+        auto last = _data.back();
+        _data.pop_back();
+        if (!_data.empty())
+        {
+            _data[0] = last;
+            siftDown(0);
+        }
+        return r;
+    }
+
+    // restores the order after the key of the node has been decreased
+    void decrease(int index)
+    {
+        siftUp(static_cast<size_t>(_positions[index]));
+    }
+
+    bool isEmpty() const
+    {
+        return _data.empty();
+    }
+
+  private:
+    void siftUp(size_t position)
+    {
+        auto index = _data[position];
+        auto key = _keys[index];
+        while (position > 0)
+        {
+            auto parent = (position - 1) / Arity;
+            if (_keys[_data[parent]] <= key)
+                break;
+            _data[position] = _data[parent];
+            _positions[_data[position]] = static_cast<int>(position);
+            position = parent;
+        }
+        _data[position] = index;
+        _positions[index] = static_cast<int>(position);
+    }
+
+    void siftDown(size_t position)
+    {
+        auto index = _data[position];
+        auto key = _keys[index];
+        auto size = _data.size();
+        while (true)
+        {
+            auto first = position * Arity + 1;
+            if (first >= size)
+                break;
+            auto last = std::min(first + Arity, size);
+            auto best = first;
+            for (auto child = first + 1; child < last; child++)
+            {
+                if (_keys[_data[child]] < _keys[_data[best]])
+                {
+                    best = child;
+                }
+            }
+            if (_keys[_data[best]] >= key)
+                break;
+            _data[position] = _data[best];
+            _positions[_data[position]] = static_cast<int>(position);
+            position = best;
+        }
+        _data[position] = index;
+        _positions[index] = static_cast<int>(position);
+    }
+};
+} // namespace ng
@@ -1,7 +1,9 @@
 #pragma once
 #include <nlohmann/json.hpp>
 #include <cmath>
+#include <iostream>
 #include <regex>
+#include <unordered_map>
 #include "Costume.h"
 #include "Object.h"
 #include "Walkbox.h"
@@ -57,106 +59,184 @@ static bool getLine(GGPackBufferStream &input, std::wstring &wline)
     return false;
 }
 
-static bool merge(const ng::Walkbox &w1, const ng::Walkbox &w2, std::vector<sf::Vector2i> &result)
+struct _EdgeKey
 {
-    // I know this implementation is ugly :S
-    sf::Vector2i v11, v12, v21, v22;
-    bool hasMerged = false;
-    for (int i1 = 0; i1 < w1.getVertices().size(); i1++)
+    sf::Vector2i v1;
+    sf::Vector2i v2;
+
+    bool operator==(const _EdgeKey &other) const { return v1 == other.v1 && v2 == other.v2; }
+};
+
+struct _EdgeKeyHash
+{
+    size_t operator()(const _EdgeKey &key) const
     {
-        v11 = w1.getVertex(i1);
-        v12 = w1.getVertex((i1 + 1) % w1.getVertices().size());
-        int iShared = -1;
-        for (int i2 = w2.getVertices().size() - 1; i2 >= 0; i2--)
-        {
-            v21 = w2.getVertex(i2);
-            auto i22 = i2;
-            if (i22 == 0)
-                i22 = w2.getVertices().size();
-            v22 = w2.getVertex(i22 - 1);
-            if (v11 == v21 && v12 == v22)
-            {
-                hasMerged = true;
-                iShared = i2;
-                break;
-            }
-        }
-        if (iShared == -1)
-        {
-            result.push_back(v11);
-        }
-        else
-        {
-            for (int i2 = iShared; i2 < w2.getVertices().size() + iShared; i2++)
-            {
-                auto i2p = i2 % w2.getVertices().size();
-                auto i2p2 = (i2p + 1) % w2.getVertices().size();
-                v21 = w2.getVertex(i2p);
-                v22 = w2.getVertex(i2p2);
-
-                int iShared2 = -1;
-                for (auto i1p = i1 + 2; i1p < w1.getVertices().size(); i1p++)
-                {
-                    v11 = w1.getVertex(i1p % w1.getVertices().size());
-                    v12 = w1.getVertex((i1p + 1) % w1.getVertices().size());
-                    if (v21 == v12 && v22 == v11)
-                    {
-                        iShared2 = i1p;
-                        break;
-                    }
-                }
-                if (iShared2 != -1)
-                {
-                    i1 = iShared2;
-                    break;
-                }
-                else
-                {
-                    result.push_back(v21);
-                }
-            }
-        }
+        auto h1 = (static_cast<uint64_t>(static_cast<uint32_t>(key.v1.x)) << 32) | static_cast<uint32_t>(key.v1.y);
+        auto h2 = (static_cast<uint64_t>(static_cast<uint32_t>(key.v2.x)) << 32) | static_cast<uint32_t>(key.v2.y);
+        return std::hash<uint64_t>()(h1 ^ (h2 * 0x9e3779b97f4a7c15ull));
+    }
+};
+
+struct _VertexHash
+{
+    size_t operator()(const sf::Vector2i &vertex) const
+    {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(static_cast<uint32_t>(vertex.x)) << 32) | static_cast<uint32_t>(vertex.y));
+    }
+};
+
+// calls f for each edge of the walkbox which is not degenerated
+template <typename F>
+static void forEachWalkboxEdge(const ng::Walkbox &walkbox, F f)
+{
+    const auto &vertices = walkbox.getVertices();
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        const auto &v1 = vertices[i];
+        const auto &v2 = vertices[(i + 1) % vertices.size()];
+        if (v1 != v2)
+            f(v1, v2);
     }
-    return hasMerged;
 }
 
-static void merge(const std::vector<ng::Walkbox> &walkboxes, std::vector<Walkbox> &result)
+// Among the outline edges leaving the end of the edge from -> to, finds the one turning the most towards
+// the inside, so the walk follows the walkable area and splits at the vertices where two parts of it touch.
+// The inside is on the left of the edges when isCounterClockwise is true. The walk stops at the vertex it
+// started from when the edge it started with is the best one, the end of the outline is returned then.
+template <typename TOutline>
+static typename TOutline::iterator _nextOutlineEdge(TOutline &outline, const sf::Vector2i &from, const sf::Vector2i &to,
+                                                    bool isCounterClockwise, const _EdgeKey &first)
 {
-    ng::Walkbox w;
-    std::list<int> walkboxesProcessed;
-    for (int i = 0; i < walkboxes.size(); i++)
+    auto din = to - from;
+    auto getTurn = [&din, &to](const sf::Vector2i &next) {
+        auto dout = next - to;
+        auto cross = static_cast<double>(din.x) * dout.y - static_cast<double>(din.y) * dout.x;
+        auto dot = static_cast<double>(din.x) * dout.x + static_cast<double>(din.y) * dout.y;
+        return std::atan2(cross, dot);
+    };
+    auto isBetter = [isCounterClockwise](double turn, double bestTurn) {
+        return isCounterClockwise ? turn > bestTurn : turn < bestTurn;
+    };
+
+    auto range = outline.equal_range(to);
+    auto best = range.first == range.second ? outline.end() : range.first;
+    for (auto it = range.first; it != range.second; ++it)
     {
-        if (walkboxes[i].isEnabled())
-        {
-            w = walkboxes[i];
-            break;
-        }
+        if (isBetter(getTurn(it->second), getTurn(best->second)))
+            best = it;
     }
+    if (to == first.v1 && (best == outline.end() || isBetter(getTurn(first.v2), getTurn(best->second))))
+        return outline.end();
+    return best;
+}
 
-    if (w.getVertices().empty())
+// Merges the first enabled walkbox with the enabled walkboxes connected to it by a shared edge,
+// the other walkboxes are kept as they are.
+// An edge shared by two walkboxes goes in opposite directions in each of them, so the edges
+// are hashed to cancel the shared ones and the remaining edges are walked to get the outlines.
+// The walk splits the merged area where it only touches itself at a vertex, each part is a walkbox.
+// A walkbox can't have a hole, when the merged area has one the connected walkboxes are kept as they are.
+static void merge(const std::vector<ng::Walkbox> &walkboxes, std::vector<Walkbox> &result)
+{
+    auto itFirst = std::find_if(walkboxes.begin(), walkboxes.end(), [](const Walkbox &w) { return w.isEnabled(); });
+    if (itFirst == walkboxes.end())
         return;
 
-    for (int i = 0; i < walkboxes.size(); i++)
+    // owner of each directed edge of the enabled walkboxes
+    std::unordered_map<_EdgeKey, size_t, _EdgeKeyHash> edges;
+    for (size_t i = 0; i < walkboxes.size(); i++)
     {
-        if (std::find(walkboxesProcessed.begin(), walkboxesProcessed.end(), i) != walkboxesProcessed.end())
+        if (!walkboxes[i].isEnabled())
             continue;
+        forEachWalkboxEdge(walkboxes[i], [&edges, i](const sf::Vector2i &v1, const sf::Vector2i &v2) {
+            edges.insert({{v1, v2}, i});
+        });
+    }
 
-        if (!walkboxes[i].isEnabled())
+    // walkboxes connected to the first one
+    std::vector<bool> isMerged(walkboxes.size(), false);
+    std::vector<size_t> connected{static_cast<size_t>(itFirst - walkboxes.begin())};
+    isMerged[connected[0]] = true;
+    for (size_t i = 0; i < connected.size(); i++)
+    {
+        forEachWalkboxEdge(walkboxes[connected[i]], [&](const sf::Vector2i &v1, const sf::Vector2i &v2) {
+            auto it = edges.find({v2, v1});
+            if (it == edges.end() || isMerged[it->second])
+                return;
+            isMerged[it->second] = true;
+            connected.push_back(it->second);
+        });
+    }
+
+    // the edges which are not shared are the outline, the sign of its area gives the side of the inside
+    std::unordered_multimap<sf::Vector2i, sf::Vector2i, _VertexHash> outline;
+    std::vector<_EdgeKey> outlineEdges;
+    int64_t area = 0;
+    for (auto index : connected)
+    {
+        forEachWalkboxEdge(walkboxes[index], [&](const sf::Vector2i &v1, const sf::Vector2i &v2) {
+            if (edges.find({v2, v1}) != edges.end())
+                return;
+            outline.insert({v1, v2});
+            outlineEdges.push_back({v1, v2});
+            area += static_cast<int64_t>(v1.x) * v2.y - static_cast<int64_t>(v2.x) * v1.y;
+        });
+    }
+
+    // walk every loop of the outline, starting in the order of the walkboxes
+    std::vector<std::vector<sf::Vector2i>> loops;
+    auto hasHole = false;
+    for (const auto &edge : outlineEdges)
+    {
+        auto range = outline.equal_range(edge.v1);
+        auto it = std::find_if(range.first, range.second, [&edge](const auto &e) { return e.second == edge.v2; });
+        if (it == range.second)
             continue;
 
         std::vector<sf::Vector2i> vertices;
-        if (merge(w, walkboxes[i], vertices))
+        int64_t loopArea = 0;
+        while (it != outline.end())
+        {
+            auto from = it->first;
+            auto to = it->second;
+            vertices.push_back(from);
+            loopArea += static_cast<int64_t>(from.x) * to.y - static_cast<int64_t>(to.x) * from.y;
+            outline.erase(it);
+            it = _nextOutlineEdge(outline, from, to, area > 0, edge);
+        }
+
+        // a loop without area is an edge split by a vertex of the walkbox on the other side, it covers nothing
+        if (loopArea == 0)
+            continue;
+        if ((loopArea > 0) != (area > 0))
         {
-            w = ng::Walkbox(vertices);
-            walkboxesProcessed.push_back(i);
-            i = -1;
+            hasHole = true;
+            break;
         }
+        loops.push_back(std::move(vertices));
     }
-    result.push_back(w);
 
-    for (int i = 0; i < walkboxes.size(); i++)
+    if (hasHole)
     {
-        if (std::find(walkboxesProcessed.begin(), walkboxesProcessed.end(), i) != walkboxesProcessed.end())
+        auto name = itFirst->getName().empty() ? "#" + std::to_string(connected[0]) : itFirst->getName();
+        std::cerr << "Walkbox " << name << " and the " << connected.size() - 1
+                  << " walkboxes connected to it surround a hole, they are not merged" << std::endl;
+        for (auto index : connected)
+        {
+            isMerged[index] = false;
+        }
+    }
+    else
+    {
+        for (auto &vertices : loops)
+        {
+            result.emplace_back(vertices);
+        }
+    }
+
+    for (size_t i = 0; i < walkboxes.size(); i++)
+    {
+        if (isMerged[i])
             continue;
 
         result.push_back(walkboxes[i]);
@@ -176,6 +256,16 @@ static float distance(const sf::Vector2i &v1, const sf::Vector2i &v2)
     return std::sqrt(distanceSquared(v1, v2));
 }
 
+// interpolates a position between two consecutive ticks, jumps (teleport, room change) are not interpolated
+static sf::Vector2f interpolate(const sf::Vector2f &previous, const sf::Vector2f &current, float alpha)
+{
+    const float maxDistance = 32.f;
+    auto delta = current - previous;
+    if (delta.x * delta.x + delta.y * delta.y > maxDistance * maxDistance)
+        return current;
+    return previous + delta * alpha;
+}
+
 static bool lineSegmentsCross(const sf::Vector2f &a, const sf::Vector2f &b, const sf::Vector2f &c, const sf::Vector2f &d)
 {
     auto denominator = ((b.x - a.x) * (d.y - c.y)) - ((b.y - a.y) * (d.x - c.x));
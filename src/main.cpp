@@ -1,8 +1,13 @@
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include "Game.h"
 #include "Engine.h"
 #include "ScriptEngine.h"
 #include "PanInputEventHandler.h"
+#include "PathFinder.h"
+#include "Preferences.h"
+#include "Lip.h"
 #include "Dialog/_AstDump.h"
 
 int main(int argc, char **argv)
@@ -22,12 +27,54 @@ int main(int argc, char **argv)
     auto scriptEngine = std::make_unique<ng::ScriptEngine>(*engine);
     try
     {
+        // on the first run, or after the packs changed, the scripts are compiled in parallel before the boot
+        scriptEngine->compileScripts();
         scriptEngine->executeScript("test.nut");
         // scriptEngine->executeBootScript();
 
+        auto renderMode = engine->getPreferences().getUserPreference("renderMode", std::string("window"));
+        if (renderMode.type() == typeid(std::string))
+        {
+            game->setRenderMode(ng::Game::parseRenderMode(std::any_cast<std::string>(renderMode)));
+        }
+        auto precomputedPaths = engine->getPreferences().getUserPreference("precomputedPaths", SQBool(SQFalse));
+        if (precomputedPaths.type() == typeid(SQBool))
+        {
+            engine->setPrecomputedPaths(std::any_cast<SQBool>(precomputedPaths) == SQTrue);
+        }
+        auto pathFinder = engine->getPreferences().getUserPreference("pathFinder", std::string("visibilityGraph"));
+        if (pathFinder.type() == typeid(std::string) && std::any_cast<std::string>(pathFinder) == "navmesh")
+        {
+            engine->setPathFinderMode(ng::PathFinderMode::NavMesh);
+        }
+        auto tickRate = engine->getPreferences().getUserPreference("tickRate", SQInteger(60));
+        if (tickRate.type() == typeid(SQInteger))
+        {
+            // bounded before the cast, a huge value would wrap around, setTickRate rejects and clamps the rest
+            auto ticksPerSecond = std::clamp<SQInteger>(std::any_cast<SQInteger>(tickRate), -1, std::numeric_limits<int>::max());
+            game->setTickRate(static_cast<int>(ticksPerSecond));
+        }
+
+        // optional binary table of the lip tracks, updated with the voice lines parsed during the game
+        auto lipTable = engine->getPreferences().getUserPreference("lipTable", std::string());
+        std::string lipTablePath;
+        if (lipTable.type() == typeid(std::string))
+        {
+            lipTablePath = std::any_cast<std::string>(lipTable);
+            if (!lipTablePath.empty())
+            {
+                engine->getLipTable().load(lipTablePath);
+            }
+        }
+
         game->getInputEventHandlers().push_back(std::make_unique<ng::PanInputEventHandler>(*engine, game->getWindow()));
         game->getInputEventHandlers().push_back(std::make_unique<ng::EngineShortcutsInputEventHandler>(*engine));
         game->run();
+
+        if (!lipTablePath.empty() && engine->getLipTable().isModified())
+        {
+            engine->getLipTable().save(lipTablePath);
+        }
     }
     catch (std::exception &e)
     {